@@ -0,0 +1,195 @@
+"""
+Mochi Robot - Asset Compiler
+
+Turns 1bpp art in assets/ (PBM, or PNG when Pillow is installed) into
+PackBits-compressed PROGMEM blobs laid out in SSD1306 page order, and
+writes them to src/assets_generated.h.
+
+Runs automatically as a PlatformIO pre-build script, or by hand:
+    python scripts/build_assets.py
+"""
+
+import os
+import re
+import sys
+
+HEADER_NAME = "assets_generated.h"
+
+
+def read_pbm(path):
+    """Return (width, height, rows) where rows[y][x] is 1 for a lit pixel."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    # Strip comments, then split header tokens
+    tokens = []
+    pos = 0
+    while len(tokens) < 3:
+        match = re.compile(rb"\s*(#[^\n]*\n\s*)*(\S+)").match(data, pos)
+        if match is None:
+            raise ValueError("%s: truncated PBM header" % path)
+        tokens.append(match.group(2))
+        pos = match.end()
+
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    if magic == b"P1":
+        bits = [int(c) for c in re.sub(rb"#[^\n]*", b"", data[pos:]).decode() if c in "01"]
+        rows = [bits[y * width:(y + 1) * width] for y in range(height)]
+    elif magic == b"P4":
+        raw = data[pos + 1:]
+        stride = (width + 7) // 8
+        rows = [[(raw[y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)]
+                for y in range(height)]
+    else:
+        raise ValueError("%s: only P1/P4 PBM files are supported" % path)
+
+    if len(rows) != height or any(len(r) != width for r in rows):
+        raise ValueError("%s: pixel data does not match %dx%d" % (path, width, height))
+    return width, height, rows
+
+
+def read_png(path):
+    try:
+        from PIL import Image
+    except ImportError:
+        raise ValueError("%s: install Pillow to compile PNG assets" % path)
+
+    image = Image.open(path).convert("LA")
+    width, height = image.size
+    # Dark, opaque pixels are lit on the OLED (same as black in PBM)
+    rows = [[1 if (image.getpixel((x, y))[1] >= 128 and image.getpixel((x, y))[0] < 128) else 0
+             for x in range(width)] for y in range(height)]
+    return width, height, rows
+
+
+def to_pages(width, height, rows):
+    """Column bytes per 8-row page, bit 0 = top row (SSD1306 GDDRAM layout)."""
+    out = []
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and rows[y][x]:
+                    byte |= 1 << bit
+            out.append(byte)
+    return out
+
+
+def packbits(data):
+    """Classic PackBits: n < 128 -> n+1 literals, n > 128 -> repeat next byte 257-n times."""
+    out = []
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            out += [257 - run, data[i]]
+            i += run
+            continue
+
+        start = i
+        while i < len(data) and i - start < 128:
+            if i + 1 < len(data) and data[i + 1] == data[i]:
+                break
+            i += 1
+        if i == start:
+            i += 1
+        out += [i - start - 1] + data[start:i]
+    return out
+
+
+def unpackbits(data, size):
+    out = []
+    i = 0
+    while len(out) < size:
+        n = data[i]
+        i += 1
+        if n < 128:
+            out += data[i:i + n + 1]
+            i += n + 1
+        elif n > 128:
+            out += [data[i]] * (257 - n)
+            i += 1
+    return out
+
+
+def symbol_name(filename):
+    base = os.path.splitext(filename)[0]
+    return "ASSET_" + re.sub(r"[^A-Za-z0-9]", "_", base).upper()
+
+
+def build(project_dir):
+    asset_dir = os.path.join(project_dir, "assets")
+    header_path = os.path.join(project_dir, "src", HEADER_NAME)
+
+    sources = sorted(f for f in os.listdir(asset_dir) if f.lower().endswith((".pbm", ".png")))
+    lines = [
+        "/*",
+        " * Mochi Robot - Compiled Image Assets",
+        " * Generated by scripts/build_assets.py from assets/ - do not edit",
+        " *",
+        " * PackBits-compressed 1bpp images in SSD1306 page order",
+        " */",
+        "",
+        "#ifndef ASSETS_GENERATED_H",
+        "#define ASSETS_GENERATED_H",
+        "",
+        "#include \"asset_blit.h\"",
+        "",
+    ]
+
+    total_raw = 0
+    total_packed = 0
+    for filename in sources:
+        path = os.path.join(asset_dir, filename)
+        if filename.lower().endswith(".png"):
+            width, height, rows = read_png(path)
+        else:
+            width, height, rows = read_pbm(path)
+
+        pages = to_pages(width, height, rows)
+        packed = packbits(pages)
+        assert unpackbits(packed, len(pages)) == pages, filename
+        compressed = len(packed) < len(pages)
+        if not compressed:
+            packed = pages  # PackBits would grow it; store raw
+
+        name = symbol_name(filename)
+        total_raw += len(pages)
+        total_packed += len(packed)
+        print("  %-24s %3dx%-3d %4d -> %4d bytes" % (filename, width, height, len(pages), len(packed)))
+
+        lines.append("// %s: %dx%d, %d bytes raw, %d in flash" % (filename, width, height, len(pages), len(packed)))
+        lines.append("static const uint8_t %s_DATA[] PROGMEM = {" % name)
+        for i in range(0, len(packed), 16):
+            lines.append("  " + ", ".join("0x%02X" % b for b in packed[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("static const PackedAsset %s = { %d, %d, %s, %s_DATA };"
+                     % (name, width, height, "true" if compressed else "false", name))
+        lines.append("")
+
+    lines.append("// Total: %d bytes raw, %d bytes in flash" % (total_raw, total_packed))
+    lines.append("")
+    lines.append("#endif")
+    lines.append("")
+    content = "\n".join(lines)
+
+    # Only touch the header when it changes, so builds stay incremental
+    old = None
+    if os.path.exists(header_path):
+        with open(header_path) as f:
+            old = f.read()
+    if old != content:
+        with open(header_path, "w") as f:
+            f.write(content)
+    print("Assets: %d images, %d bytes raw, %d bytes in flash" % (len(sources), total_raw, total_packed))
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    build(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        build(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
@@ -0,0 +1,105 @@
+"""
+Mochi Robot - Frame Mirror Viewer
+
+Connects to the robot's frame mirror (src/frame_mirror.h, TCP port 3333),
+rebuilds each frame from the XOR-delta + PackBits packets and draws it in
+the terminal, with the bytes the last packet cost.
+
+    python scripts/mirror_viewer.py 192.168.1.42
+    python scripts/mirror_viewer.py 192.168.1.42 --save frame.pbm
+"""
+
+import argparse
+import os
+import socket
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from build_assets import unpackbits  # noqa: E402
+
+MIRROR_PORT = 3333
+HEADER_BYTES = 8
+FLAG_KEYFRAME = 0x01
+
+
+def read_exact(sock, count):
+    data = b""
+    while len(data) < count:
+        chunk = sock.recv(count - len(data))
+        if not chunk:
+            raise ConnectionError("mirror closed the connection")
+        data += chunk
+    return data
+
+
+def read_packet(sock):
+    """Return (flags, seq, width, height, payload) for the next packet."""
+    header = read_exact(sock, HEADER_BYTES)
+    if header[0:2] != b"MF":
+        raise ValueError("bad packet magic %r" % header[0:2])
+    length = header[6] | (header[7] << 8)
+    return header[2], header[3], header[4], header[5], read_exact(sock, length)
+
+
+def apply_delta(frame, payload):
+    delta = unpackbits(list(payload), len(frame))
+    for i in range(len(frame)):
+        frame[i] ^= delta[i]
+
+
+def render(frame, width, height):
+    """Two pixel rows per text line using half blocks."""
+    lines = []
+    for y in range(0, height, 2):
+        line = []
+        for x in range(width):
+            top = frame[x + (y // 8) * width] >> (y & 7) & 1
+            bottom = frame[x + ((y + 1) // 8) * width] >> ((y + 1) & 7) & 1
+            line.append(" ▀▄█"[top | bottom << 1])
+        lines.append("".join(line))
+    return "\n".join(lines)
+
+
+def save_pbm(path, frame, width, height):
+    with open(path, "w") as f:
+        f.write("P1\n%d %d\n" % (width, height))
+        for y in range(height):
+            f.write(" ".join(str(frame[x + (y // 8) * width] >> (y & 7) & 1) for x in range(width)))
+            f.write("\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Show the Mochi OLED over WiFi")
+    parser.add_argument("host")
+    parser.add_argument("--port", type=int, default=MIRROR_PORT)
+    parser.add_argument("--save", help="also write every frame to this PBM file")
+    args = parser.parse_args()
+
+    sock = socket.create_connection((args.host, args.port))
+    frame = None
+    packets = 0
+    total = 0
+    try:
+        while True:
+            flags, seq, width, height, payload = read_packet(sock)
+            if frame is None or flags & FLAG_KEYFRAME or len(frame) != width * height // 8:
+                frame = [0] * (width * height // 8)
+            apply_delta(frame, payload)
+
+            packets += 1
+            total += HEADER_BYTES + len(payload)
+            sys.stdout.write("\x1b[H\x1b[2J" + render(frame, width, height) + "\n")
+            sys.stdout.write("seq %3d  %4d bytes  (avg %d)%s\n" % (
+                seq, HEADER_BYTES + len(payload), total // packets,
+                "  keyframe" if flags & FLAG_KEYFRAME else ""))
+            sys.stdout.flush()
+            if args.save:
+                save_pbm(args.save, frame, width, height)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sock.close()
+
+
+if __name__ == "__main__":
+    main()
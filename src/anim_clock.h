@@ -0,0 +1,56 @@
+/*
+ * Mochi Robot - Animation Clock
+ * Time-based animation phases shared by the face renderers
+ *
+ * Animations advance with millis(), not with draw calls, so the same
+ * motion plays at any frame rate and a skipped frame just shows the
+ * next phase. One tick is the 50 ms step the old per-draw counters
+ * assumed at ~20 fps.
+ */
+
+#ifndef ANIM_CLOCK_H
+#define ANIM_CLOCK_H
+
+#include <stdint.h>
+
+#define ANIM_TICK_MS   50
+#define ANIM_BLINK_MS  3000          // Eyes toggle open/closed
+#define ANIM_NO_CHANGE 0xFFFFFFFFUL  // Nothing scheduled
+
+// How a face's looks cycle over time
+struct AnimPhase {
+  uint16_t stepMs; // Look changes every stepMs (0 = static)
+  uint8_t steps;   // Distinct looks per cycle
+  bool blinks;     // Also follows the blink timeline
+};
+
+inline uint32_t animTick(unsigned long elapsedMs) {
+  return elapsedMs / ANIM_TICK_MS;
+}
+
+inline bool animEyesOpen(unsigned long elapsedMs) {
+  return (elapsedMs / ANIM_BLINK_MS) % 2 == 0;
+}
+
+// Index of the current look, unique per visual state (sprite cache key)
+inline uint8_t animPhaseIndex(const AnimPhase& phase, unsigned long elapsedMs) {
+  uint8_t index = 0;
+  if (phase.blinks) index |= !animEyesOpen(elapsedMs);
+  if (phase.stepMs > 0) index |= ((elapsedMs / phase.stepMs) % phase.steps) << 1;
+  return index;
+}
+
+// Milliseconds until the look next changes, or ANIM_NO_CHANGE
+inline unsigned long animTimeToChange(const AnimPhase& phase, unsigned long elapsedMs) {
+  unsigned long wait = ANIM_NO_CHANGE;
+  if (phase.stepMs > 0) {
+    wait = phase.stepMs - elapsedMs % phase.stepMs;
+  }
+  if (phase.blinks) {
+    unsigned long blink = ANIM_BLINK_MS - elapsedMs % ANIM_BLINK_MS;
+    if (blink < wait) wait = blink;
+  }
+  return wait;
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Mochi Robot - Elliptical Arc Rasterizer Implementation
+ */
+
+#include "arc_raster.h"
+#include "fixed_trig.h"
+
+// Angular window an ellipse point must fall into
+struct ArcClip {
+  int32_t startX, startY; // Q15 unit vector of startAngle
+  int32_t endX, endY;     // Q15 unit vector of endAngle
+  bool fullCircle;
+  bool reflex;            // Sweep larger than 180 degrees
+};
+
+static inline int32_t cross(int32_t ax, int32_t ay, int32_t bx, int32_t by) {
+  return ax * by - ay * bx;
+}
+
+// dx/dy are scaled to the ellipse's parametric angle before testing
+static bool insideArc(const ArcClip& clip, int32_t dx, int32_t dy) {
+  if (clip.fullCircle) return true;
+
+  if (clip.reflex) {
+    // Outside only if strictly between end and start
+    return !(cross(clip.endX, clip.endY, dx, dy) > 0 &&
+             cross(dx, dy, clip.startX, clip.startY) > 0);
+  }
+  return cross(clip.startX, clip.startY, dx, dy) >= 0 &&
+         cross(dx, dy, clip.endX, clip.endY) >= 0;
+}
+
+static void plotQuadrants(Adafruit_GFX* gfx, const ArcClip& clip, int x, int y,
+                          int dx, int dy, int radiusX, int radiusY, uint16_t color) {
+  // Scale so the vector points along the parametric angle (cos t, sin t)
+  int32_t sx = (int32_t)dx * radiusY;
+  int32_t sy = (int32_t)dy * radiusX;
+
+  if (insideArc(clip, sx, sy)) gfx->drawPixel(x + dx, y + dy, color);
+  if (dx != 0 && insideArc(clip, -sx, sy)) gfx->drawPixel(x - dx, y + dy, color);
+  if (dy != 0 && insideArc(clip, sx, -sy)) gfx->drawPixel(x + dx, y - dy, color);
+  if (dx != 0 && dy != 0 && insideArc(clip, -sx, -sy)) gfx->drawPixel(x - dx, y - dy, color);
+}
+
+static void rasterRing(Adafruit_GFX* gfx, const ArcClip& clip, int x, int y,
+                       int radiusX, int radiusY, uint16_t color) {
+  // Decision variables are scaled by 4 to stay in integers
+  int32_t rx2 = (int32_t)radiusX * radiusX;
+  int32_t ry2 = (int32_t)radiusY * radiusY;
+  int dx = 0;
+  int dy = radiusY;
+
+  // Region 1: slope shallower than -1
+  int32_t d = 4 * ry2 - 4 * rx2 * radiusY + rx2;
+  while (ry2 * dx < rx2 * dy) {
+    plotQuadrants(gfx, clip, x, y, dx, dy, radiusX, radiusY, color);
+    if (d < 0) {
+      d += 4 * ry2 * (2 * dx + 3);
+    } else {
+      d += 4 * ry2 * (2 * dx + 3) - 8 * rx2 * (dy - 1);
+      dy--;
+    }
+    dx++;
+  }
+
+  // Region 2: slope steeper than -1
+  d = ry2 * (2 * dx + 1) * (2 * dx + 1) + 4 * rx2 * (dy - 1) * (dy - 1) - 4 * rx2 * ry2;
+  int lastX = dx;
+  while (dy >= 0) {
+    plotQuadrants(gfx, clip, x, y, dx, dy, radiusX, radiusY, color);
+    lastX = dx;
+    if (d > 0) {
+      d += 4 * rx2 * (3 - 2 * dy);
+    } else {
+      d += ry2 * (8 * dx + 8) + 4 * rx2 * (3 - 2 * dy);
+      dx++;
+    }
+    dy--;
+  }
+
+  // Very flat ellipses can reach the axis before the tip; finish the tail
+  for (int tail = lastX + 1; tail <= radiusX; tail++) {
+    plotQuadrants(gfx, clip, x, y, tail, 0, radiusX, radiusY, color);
+  }
+}
+
+void drawEllipseArc(Adafruit_GFX* gfx, int x, int y, int radiusX, int radiusY,
+                    int startAngle, int endAngle, int thickness, uint16_t color) {
+  if (endAngle < startAngle) {
+    int swap = startAngle;
+    startAngle = endAngle;
+    endAngle = swap;
+  }
+
+  ArcClip clip;
+  clip.startX = fixedCos(startAngle);
+  clip.startY = fixedSin(startAngle);
+  clip.endX = fixedCos(endAngle);
+  clip.endY = fixedSin(endAngle);
+  clip.fullCircle = (endAngle - startAngle) >= 360;
+  clip.reflex = (endAngle - startAngle) > 180;
+
+  if (thickness < 1) thickness = 1;
+  for (int ring = 0; ring < thickness; ring++) {
+    int rx = radiusX - ring;
+    int ry = radiusY - ring;
+    if (rx < 1 || ry < 1) break;
+    rasterRing(gfx, clip, x, y, rx, ry, color);
+  }
+}
@@ -0,0 +1,18 @@
+/*
+ * Mochi Robot - Elliptical Arc Rasterizer
+ * Integer midpoint (Bresenham-style) ellipse with angle clipping
+ *
+ * Angles are in degrees, 0 is right, 90 is down (screen coordinates).
+ * Arcs run from startAngle to endAngle in increasing angle order.
+ */
+
+#ifndef ARC_RASTER_H
+#define ARC_RASTER_H
+
+#include <Adafruit_GFX.h>
+
+// Draw an elliptical arc; thickness > 1 adds concentric inner rings
+void drawEllipseArc(Adafruit_GFX* gfx, int x, int y, int radiusX, int radiusY,
+                    int startAngle, int endAngle, int thickness, uint16_t color);
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * Mochi Robot - Asset Blitter Implementation
+ */
+
+#include "asset_blit.h"
+#include <Arduino.h>
+
+// Destination state shared by the decoder loop
+struct BlitTarget {
+  uint8_t* buffer;
+  int panelWidth;
+  int panelPages;
+  int x;
+  int page;  // Page of the image's first row (may be negative)
+  int shift; // Row offset inside that page
+  uint8_t width;
+};
+
+static inline void putColumn(const BlitTarget& target, int index, uint8_t bits) {
+  if (bits == 0) return;
+
+  int col = target.x + index % target.width;
+  if (col < 0 || col >= target.panelWidth) return;
+
+  int page = target.page + index / target.width;
+  if (page >= 0 && page < target.panelPages) {
+    target.buffer[page * target.panelWidth + col] |= bits << target.shift;
+  }
+  if (target.shift != 0 && page + 1 >= 0 && page + 1 < target.panelPages) {
+    target.buffer[(page + 1) * target.panelWidth + col] |= bits >> (8 - target.shift);
+  }
+}
+
+void blitAsset(Adafruit_SSD1306* display, const PackedAsset& asset, int x, int y) {
+  BlitTarget target;
+  target.buffer = display->getBuffer();
+  if (target.buffer == nullptr) return;
+  target.panelWidth = display->width();
+  target.panelPages = display->height() / 8;
+  target.x = x;
+  target.page = (y >= 0) ? (y / 8) : -((7 - y) / 8); // floor(y / 8)
+  target.shift = y - target.page * 8;
+  target.width = asset.width;
+
+  int total = asset.width * ((asset.height + 7) / 8);
+  const uint8_t* src = asset.data;
+
+  if (!asset.compressed) {
+    for (int i = 0; i < total; i++) {
+      putColumn(target, i, pgm_read_byte(src + i));
+    }
+    return;
+  }
+
+  // PackBits: n < 128 -> n+1 literal bytes, n > 128 -> next byte repeated 257-n times
+  int index = 0;
+  while (index < total) {
+    uint8_t n = pgm_read_byte(src++);
+    if (n < 128) {
+      for (int i = 0; i <= n && index < total; i++) {
+        putColumn(target, index++, pgm_read_byte(src++));
+      }
+    } else if (n > 128) {
+      uint8_t bits = pgm_read_byte(src++);
+      for (int i = 0; i < 257 - n && index < total; i++) {
+        putColumn(target, index++, bits);
+      }
+    }
+  }
+}
@@ -0,0 +1,25 @@
+/*
+ * Mochi Robot - Asset Blitter
+ * Draws build-time compressed images straight into the SSD1306 buffer
+ *
+ * Images come from scripts/build_assets.py (see assets_generated.h).
+ */
+
+#ifndef ASSET_BLIT_H
+#define ASSET_BLIT_H
+
+#include <Adafruit_SSD1306.h>
+
+// 1bpp image in SSD1306 page order, optionally PackBits-compressed
+struct PackedAsset {
+  uint8_t width;
+  uint8_t height;
+  bool compressed;
+  const uint8_t* data; // PROGMEM
+};
+
+// OR the image into the display buffer with its top-left corner at (x, y).
+// Decompresses on the fly; any y works, page-aligned y is fastest.
+void blitAsset(Adafruit_SSD1306* display, const PackedAsset& asset, int x, int y);
+
+#endif
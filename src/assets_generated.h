@@ -0,0 +1,215 @@
+/*
+ * Mochi Robot - Compiled Image Assets
+ * Generated by scripts/build_assets.py from assets/ - do not edit
+ *
+ * PackBits-compressed 1bpp images in SSD1306 page order
+ */
+
+#ifndef ASSETS_GENERATED_H
+#define ASSETS_GENERATED_H
+
+#include "asset_blit.h"
+
+// status_bt.pbm: 8x8, 8 bytes raw, 8 in flash
+static const uint8_t ASSET_STATUS_BT_DATA[] PROGMEM = {
+  0x24, 0x18, 0xFF, 0x5A, 0x24, 0x00, 0x00, 0x00,
+};
+static const PackedAsset ASSET_STATUS_BT = { 8, 8, false, ASSET_STATUS_BT_DATA };
+
+// status_cached.pbm: 8x8, 8 bytes raw, 8 in flash
+static const uint8_t ASSET_STATUS_CACHED_DATA[] PROGMEM = {
+  0x7F, 0x41, 0x77, 0x57, 0x77, 0x41, 0x7F, 0x00,
+};
+static const PackedAsset ASSET_STATUS_CACHED = { 8, 8, false, ASSET_STATUS_CACHED_DATA };
+
+// status_sync.pbm: 8x8, 8 bytes raw, 8 in flash
+static const uint8_t ASSET_STATUS_SYNC_DATA[] PROGMEM = {
+  0x1C, 0x22, 0x41, 0x4F, 0x49, 0x22, 0x1C, 0x00,
+};
+static const PackedAsset ASSET_STATUS_SYNC = { 8, 8, false, ASSET_STATUS_SYNC_DATA };
+
+// status_wifi_off.pbm: 8x8, 8 bytes raw, 8 in flash
+static const uint8_t ASSET_STATUS_WIFI_OFF_DATA[] PROGMEM = {
+  0x00, 0x22, 0x14, 0x08, 0x14, 0x22, 0x00, 0x00,
+};
+static const PackedAsset ASSET_STATUS_WIFI_OFF = { 8, 8, false, ASSET_STATUS_WIFI_OFF_DATA };
+
+// status_wifi_on.pbm: 8x8, 8 bytes raw, 8 in flash
+static const uint8_t ASSET_STATUS_WIFI_ON_DATA[] PROGMEM = {
+  0x02, 0x09, 0x25, 0x55, 0x55, 0x25, 0x09, 0x02,
+};
+static const PackedAsset ASSET_STATUS_WIFI_ON = { 8, 8, false, ASSET_STATUS_WIFI_ON_DATA };
+
+// weather_clear_16.pbm: 16x16, 32 bytes raw, 32 in flash
+static const uint8_t ASSET_WEATHER_CLEAR_16_DATA[] PROGMEM = {
+  0x80, 0x80, 0x84, 0x08, 0x10, 0xC0, 0xE0, 0xE7, 0xE7, 0xE0, 0xC0, 0x10, 0x08, 0x84, 0x80, 0x80,
+  0x01, 0x01, 0x21, 0x10, 0x08, 0x03, 0x07, 0xE7, 0xE7, 0x07, 0x03, 0x08, 0x10, 0x21, 0x01, 0x01,
+};
+static const PackedAsset ASSET_WEATHER_CLEAR_16 = { 16, 16, false, ASSET_WEATHER_CLEAR_16_DATA };
+
+// weather_clear_32.pbm: 32x32, 128 bytes raw, 80 in flash
+static const uint8_t ASSET_WEATHER_CLEAR_32_DATA[] PROGMEM = {
+  0xFC, 0x00, 0x03, 0x60, 0xE0, 0xC0, 0x80, 0xFB, 0x00, 0xFF, 0x7F, 0xFB, 0x00, 0x03, 0x80, 0xC0,
+  0xE0, 0x60, 0xFC, 0x00, 0xFA, 0x80, 0x05, 0x01, 0x03, 0xE3, 0xF0, 0xF8, 0xFC, 0xFB, 0xFE, 0x05,
+  0xFC, 0xF8, 0xF0, 0xE3, 0x03, 0x01, 0xFA, 0x80, 0xFA, 0x01, 0x05, 0x80, 0xC0, 0xC7, 0x0F, 0x1F,
+  0x3F, 0xFB, 0x7F, 0x05, 0x3F, 0x1F, 0x0F, 0xC7, 0xC0, 0x80, 0xFA, 0x01, 0xFC, 0x00, 0x03, 0x06,
+  0x07, 0x03, 0x01, 0xFB, 0x00, 0xFF, 0xFE, 0xFB, 0x00, 0x03, 0x01, 0x03, 0x07, 0x06, 0xFC, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_CLEAR_32 = { 32, 32, true, ASSET_WEATHER_CLEAR_32_DATA };
+
+// weather_clouds_16.pbm: 16x16, 32 bytes raw, 30 in flash
+static const uint8_t ASSET_WEATHER_CLOUDS_16_DATA[] PROGMEM = {
+  0x0B, 0x00, 0xE0, 0x30, 0x1C, 0x04, 0x06, 0xC4, 0x4C, 0x78, 0x30, 0x60, 0xC0, 0xFC, 0x00, 0xFF,
+  0x01, 0x03, 0x0D, 0x1F, 0x33, 0x21, 0xFD, 0x20, 0x04, 0x21, 0x33, 0x16, 0x1C, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_CLOUDS_16 = { 16, 16, true, ASSET_WEATHER_CLOUDS_16_DATA };
+
+// weather_clouds_32.pbm: 32x32, 128 bytes raw, 86 in flash
+static const uint8_t ASSET_WEATHER_CLOUDS_32_DATA[] PROGMEM = {
+  0xFC, 0x00, 0x03, 0x80, 0xE0, 0x30, 0x18, 0xFD, 0x08, 0x04, 0x18, 0x10, 0x30, 0xE0, 0x80, 0xF2,
+  0x00, 0x04, 0x78, 0xCC, 0x06, 0x02, 0x03, 0xFC, 0x00, 0x03, 0x80, 0xE0, 0x30, 0x18, 0xFF, 0x08,
+  0x00, 0x0F, 0xFF, 0x0E, 0x04, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0xF8, 0x00, 0xFF, 0x01, 0x00, 0x03,
+  0xFF, 0x02, 0x04, 0xFA, 0x0E, 0x06, 0x02, 0x03, 0xF5, 0x00, 0x05, 0x03, 0x02, 0x06, 0x04, 0x9C,
+  0xF0, 0xF8, 0x00, 0x02, 0x01, 0x03, 0x06, 0xFF, 0x04, 0x00, 0x0C, 0xF6, 0x08, 0x00, 0x0C, 0xFF,
+  0x04, 0x01, 0x06, 0x03, 0xFE, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_CLOUDS_32 = { 32, 32, true, ASSET_WEATHER_CLOUDS_32_DATA };
+
+// weather_drizzle_16.pbm: 16x16, 32 bytes raw, 32 in flash
+static const uint8_t ASSET_WEATHER_DRIZZLE_16_DATA[] PROGMEM = {
+  0x00, 0x00, 0x00, 0xE0, 0x30, 0x18, 0x0E, 0x02, 0x02, 0x02, 0x02, 0x0E, 0x18, 0x30, 0xE0, 0x00,
+  0x00, 0x00, 0x00, 0x01, 0x13, 0x12, 0x82, 0x02, 0x02, 0x82, 0x12, 0x12, 0x02, 0x03, 0x01, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_DRIZZLE_16 = { 16, 16, false, ASSET_WEATHER_DRIZZLE_16_DATA };
+
+// weather_drizzle_32.pbm: 32x32, 128 bytes raw, 72 in flash
+static const uint8_t ASSET_WEATHER_DRIZZLE_32_DATA[] PROGMEM = {
+  0xF7, 0x00, 0x05, 0xC0, 0x70, 0x18, 0x0C, 0x04, 0x06, 0xFD, 0x02, 0x05, 0x06, 0x04, 0x0C, 0x18,
+  0x70, 0xC0, 0xF6, 0x00, 0x05, 0xF0, 0x9C, 0x06, 0x02, 0x03, 0x01, 0xF3, 0x00, 0x05, 0x01, 0x03,
+  0x02, 0x06, 0x9C, 0xF0, 0xFA, 0x00, 0x03, 0x03, 0x06, 0x04, 0x0C, 0xF1, 0x08, 0x03, 0x0C, 0x04,
+  0x06, 0x03, 0xF6, 0x00, 0xFF, 0x03, 0x00, 0x00, 0xFF, 0xC0, 0x00, 0x00, 0xFF, 0x18, 0x00, 0x00,
+  0xFF, 0xC0, 0x00, 0x00, 0xFF, 0x03, 0xF8, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_DRIZZLE_32 = { 32, 32, true, ASSET_WEATHER_DRIZZLE_32_DATA };
+
+// weather_few_clouds_16.pbm: 16x16, 32 bytes raw, 31 in flash
+static const uint8_t ASSET_WEATHER_FEW_CLOUDS_16_DATA[] PROGMEM = {
+  0x0B, 0x20, 0x22, 0x04, 0x70, 0xF8, 0xFB, 0xF8, 0xF0, 0xC4, 0x62, 0xE0, 0xA0, 0xFC, 0x00, 0x06,
+  0x02, 0x01, 0x00, 0x1C, 0x36, 0x23, 0x21, 0xFE, 0x20, 0x04, 0x21, 0x23, 0x36, 0x1C, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_FEW_CLOUDS_16 = { 16, 16, true, ASSET_WEATHER_FEW_CLOUDS_16_DATA };
+
+// weather_few_clouds_32.pbm: 32x32, 128 bytes raw, 84 in flash
+static const uint8_t ASSET_WEATHER_FEW_CLOUDS_32_DATA[] PROGMEM = {
+  0xFF, 0x00, 0x05, 0x0C, 0x1C, 0x38, 0x30, 0x00, 0x80, 0xFF, 0xC0, 0xFF, 0xCF, 0xFF, 0xC0, 0x05,
+  0x80, 0x00, 0x30, 0x38, 0x1C, 0x0C, 0xF5, 0x00, 0xFD, 0x0C, 0xFF, 0x00, 0x01, 0x3F, 0x7F, 0xFA,
+  0xFF, 0x02, 0x7F, 0x20, 0x30, 0xFE, 0x1C, 0x03, 0x3C, 0x6C, 0xC0, 0x80, 0xF8, 0x00, 0x03, 0x0C,
+  0x0E, 0x07, 0x03, 0xFF, 0x00, 0x05, 0xC0, 0x70, 0x1C, 0x0C, 0x04, 0x07, 0xF7, 0x00, 0x05, 0x01,
+  0x07, 0x0C, 0x08, 0x18, 0xF0, 0xF7, 0x00, 0x03, 0x01, 0x03, 0x06, 0x0C, 0xF2, 0x08, 0x02, 0x0C,
+  0x06, 0x03, 0xFF, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_FEW_CLOUDS_32 = { 32, 32, true, ASSET_WEATHER_FEW_CLOUDS_32_DATA };
+
+// weather_mist_16.pbm: 16x16, 32 bytes raw, 18 in flash
+static const uint8_t ASSET_WEATHER_MIST_16_DATA[] PROGMEM = {
+  0xFF, 0x00, 0xFF, 0x18, 0xF9, 0x58, 0xFF, 0x40, 0xFD, 0x00, 0xFF, 0x02, 0xF8, 0x12, 0x00, 0x10,
+  0xFF, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_MIST_16 = { 16, 16, true, ASSET_WEATHER_MIST_16_DATA };
+
+// weather_mist_32.pbm: 32x32, 128 bytes raw, 34 in flash
+static const uint8_t ASSET_WEATHER_MIST_32_DATA[] PROGMEM = {
+  0xFD, 0x00, 0xEC, 0x80, 0xF6, 0x00, 0xFE, 0x01, 0x00, 0x21, 0xF0, 0x71, 0xFF, 0x70, 0x00, 0x20,
+  0xF9, 0x00, 0xFD, 0x0C, 0xF0, 0x8C, 0xFF, 0x80, 0xF5, 0x00, 0x00, 0x01, 0xEE, 0x03, 0x00, 0x01,
+  0xFD, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_MIST_32 = { 32, 32, true, ASSET_WEATHER_MIST_32_DATA };
+
+// weather_rain_16.pbm: 16x16, 32 bytes raw, 30 in flash
+static const uint8_t ASSET_WEATHER_RAIN_16_DATA[] PROGMEM = {
+  0xFE, 0x00, 0x03, 0xE0, 0x30, 0x18, 0x0E, 0xFD, 0x02, 0x03, 0x0E, 0x18, 0x30, 0xE0, 0xFD, 0x00,
+  0x0C, 0x01, 0xC3, 0x3A, 0x0A, 0xC2, 0x3A, 0x0A, 0xC2, 0x3A, 0x0A, 0x03, 0x01, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_RAIN_16 = { 16, 16, true, ASSET_WEATHER_RAIN_16_DATA };
+
+// weather_rain_32.pbm: 32x32, 128 bytes raw, 82 in flash
+static const uint8_t ASSET_WEATHER_RAIN_32_DATA[] PROGMEM = {
+  0xF7, 0x00, 0x05, 0xC0, 0x70, 0x18, 0x0C, 0x04, 0x06, 0xFD, 0x02, 0x05, 0x06, 0x04, 0x0C, 0x18,
+  0x70, 0xC0, 0xF6, 0x00, 0x05, 0xF0, 0x9C, 0x06, 0x02, 0x03, 0x01, 0xF3, 0x00, 0x05, 0x01, 0x03,
+  0x02, 0x06, 0x9C, 0xF0, 0xFA, 0x00, 0x04, 0x03, 0x06, 0x04, 0x0C, 0x08, 0xFF, 0xC8, 0xFD, 0x08,
+  0xFF, 0xC8, 0xFD, 0x08, 0xFF, 0xC8, 0x04, 0x08, 0x0C, 0x04, 0x06, 0x03, 0xF7, 0x00, 0x10, 0x70,
+  0x7C, 0x1F, 0x07, 0x01, 0x00, 0x70, 0x7C, 0x1F, 0x07, 0x01, 0x00, 0x70, 0x7C, 0x1F, 0x07, 0x01,
+  0xFA, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_RAIN_32 = { 32, 32, true, ASSET_WEATHER_RAIN_32_DATA };
+
+// weather_snow_16.pbm: 16x16, 32 bytes raw, 31 in flash
+static const uint8_t ASSET_WEATHER_SNOW_16_DATA[] PROGMEM = {
+  0xFE, 0x00, 0x03, 0xE0, 0x30, 0x18, 0x0E, 0xFD, 0x02, 0x03, 0x0E, 0x18, 0x30, 0xE0, 0xFD, 0x00,
+  0x03, 0x01, 0x73, 0x22, 0x72, 0xFF, 0x02, 0x06, 0x72, 0x22, 0x72, 0x02, 0x03, 0x01, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_SNOW_16 = { 16, 16, true, ASSET_WEATHER_SNOW_16_DATA };
+
+// weather_snow_32.pbm: 32x32, 128 bytes raw, 76 in flash
+static const uint8_t ASSET_WEATHER_SNOW_32_DATA[] PROGMEM = {
+  0xF7, 0x00, 0x05, 0xC0, 0x70, 0x18, 0x0C, 0x04, 0x06, 0xFD, 0x02, 0x05, 0x06, 0x04, 0x0C, 0x18,
+  0x70, 0xC0, 0xF6, 0x00, 0x05, 0xF0, 0x9C, 0x06, 0x02, 0x03, 0x01, 0xF3, 0x00, 0x05, 0x01, 0x03,
+  0x02, 0x06, 0x9C, 0xF0, 0xFA, 0x00, 0x03, 0x03, 0x06, 0x04, 0x0C, 0xF1, 0x08, 0x03, 0x0C, 0x04,
+  0x06, 0x03, 0xF8, 0x00, 0x02, 0x0C, 0x2D, 0x3F, 0xFF, 0x1E, 0x02, 0x3F, 0x2D, 0x0C, 0xFF, 0x00,
+  0x02, 0x0C, 0x2D, 0x3F, 0xFF, 0x1E, 0x02, 0x3F, 0x2D, 0x0C, 0xFA, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_SNOW_32 = { 32, 32, true, ASSET_WEATHER_SNOW_32_DATA };
+
+// weather_thunderstorm_16.pbm: 16x16, 32 bytes raw, 30 in flash
+static const uint8_t ASSET_WEATHER_THUNDERSTORM_16_DATA[] PROGMEM = {
+  0xFE, 0x00, 0x03, 0xE0, 0x30, 0x18, 0x0E, 0xFD, 0x02, 0x03, 0x0E, 0x18, 0x30, 0xE0, 0xFD, 0x00,
+  0x06, 0x01, 0x03, 0x02, 0xA2, 0xFA, 0x7E, 0x16, 0xFE, 0x02, 0x02, 0x03, 0x01, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_THUNDERSTORM_16 = { 16, 16, true, ASSET_WEATHER_THUNDERSTORM_16_DATA };
+
+// weather_thunderstorm_32.pbm: 32x32, 128 bytes raw, 72 in flash
+static const uint8_t ASSET_WEATHER_THUNDERSTORM_32_DATA[] PROGMEM = {
+  0xF7, 0x00, 0x05, 0xC0, 0x70, 0x18, 0x0C, 0x04, 0x06, 0xFD, 0x02, 0x05, 0x06, 0x04, 0x0C, 0x18,
+  0x70, 0xC0, 0xF6, 0x00, 0x05, 0xF0, 0x9C, 0x06, 0x02, 0x03, 0x01, 0xF3, 0x00, 0x05, 0x01, 0x03,
+  0x02, 0x06, 0x9C, 0xF0, 0xFA, 0x00, 0x03, 0x03, 0x06, 0x04, 0x0C, 0xFD, 0x08, 0x05, 0x88, 0xC8,
+  0xE8, 0xF8, 0x38, 0x18, 0xFB, 0x08, 0x03, 0x0C, 0x04, 0x06, 0x03, 0xF3, 0x00, 0x07, 0x0C, 0xCE,
+  0xEF, 0xF7, 0x3F, 0x1F, 0x0F, 0x03, 0xF5, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_THUNDERSTORM_32 = { 32, 32, true, ASSET_WEATHER_THUNDERSTORM_32_DATA };
+
+// weather_unknown_16.pbm: 16x16, 32 bytes raw, 32 in flash
+static const uint8_t ASSET_WEATHER_UNKNOWN_16_DATA[] PROGMEM = {
+  0x00, 0xF0, 0x18, 0x0C, 0x06, 0x32, 0x1A, 0x0A, 0x8A, 0x5A, 0x32, 0x06, 0x0C, 0x18, 0xF0, 0x00,
+  0x00, 0x0F, 0x18, 0x30, 0x60, 0x40, 0x40, 0x53, 0x53, 0x40, 0x40, 0x60, 0x30, 0x18, 0x0F, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_UNKNOWN_16 = { 16, 16, false, ASSET_WEATHER_UNKNOWN_16_DATA };
+
+// weather_unknown_32.pbm: 32x32, 128 bytes raw, 103 in flash
+static const uint8_t ASSET_WEATHER_UNKNOWN_32_DATA[] PROGMEM = {
+  0xFD, 0x00, 0x08, 0xC0, 0x60, 0x30, 0x10, 0x18, 0x0C, 0x04, 0x84, 0xC6, 0xFB, 0xC2, 0x08, 0xC6,
+  0x84, 0x04, 0x0C, 0x18, 0x10, 0x30, 0x60, 0xC0, 0xFC, 0x00, 0x03, 0xF0, 0x1E, 0x03, 0x01, 0xFC,
+  0x00, 0x0B, 0x0E, 0x0F, 0x07, 0x01, 0x00, 0x80, 0xC0, 0xE0, 0x71, 0x3F, 0x1F, 0x0E, 0xFC, 0x00,
+  0x03, 0x01, 0x03, 0x1E, 0xF0, 0xFF, 0x00, 0x03, 0x0F, 0x78, 0xC0, 0x80, 0xF7, 0x00, 0xFF, 0x9F,
+  0xF7, 0x00, 0x03, 0x80, 0xC0, 0x78, 0x0F, 0xFC, 0x00, 0x05, 0x03, 0x06, 0x0C, 0x08, 0x18, 0x30,
+  0xFF, 0x20, 0x02, 0x60, 0x40, 0x43, 0xFF, 0x47, 0x02, 0x43, 0x40, 0x60, 0xFF, 0x20, 0x05, 0x30,
+  0x18, 0x08, 0x0C, 0x06, 0x03, 0xFD, 0x00,
+};
+static const PackedAsset ASSET_WEATHER_UNKNOWN_32 = { 32, 32, true, ASSET_WEATHER_UNKNOWN_32_DATA };
+
+// wifi_off.pbm: 12x13, 24 bytes raw, 24 in flash
+static const uint8_t ASSET_WIFI_OFF_DATA[] PROGMEM = {
+  0x00, 0x00, 0x04, 0x08, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x08, 0x04, 0x00, 0x00, 0x00, 0x0E, 0x03,
+  0x0F, 0x0A, 0x1F, 0x0A, 0x0F, 0x0B, 0x0E, 0x08,
+};
+static const PackedAsset ASSET_WIFI_OFF = { 12, 13, false, ASSET_WIFI_OFF_DATA };
+
+// wifi_on.pbm: 12x13, 24 bytes raw, 21 in flash
+static const uint8_t ASSET_WIFI_ON_DATA[] PROGMEM = {
+  0xFD, 0x00, 0xFF, 0x80, 0x00, 0xC0, 0xFF, 0x80, 0xFC, 0x00, 0x09, 0x0E, 0x01, 0x0E, 0x0A, 0x1F,
+  0x0A, 0x0E, 0x09, 0x0E, 0x08,
+};
+static const PackedAsset ASSET_WIFI_ON = { 12, 13, true, ASSET_WIFI_ON_DATA };
+
+// Total: 1528 bytes raw, 1040 bytes in flash
+
+#endif
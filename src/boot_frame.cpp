@@ -0,0 +1,126 @@
+/*
+ * Mochi Robot - Boot Frame Implementation
+ */
+
+#include "boot_frame.h"
+
+// Not cleared by the startup code: survives software resets and deep sleep
+RTC_NOINIT_ATTR static BootSnapshot rtcSnapshot;
+
+BootFrame::BootFrame(Preferences* prefs) {
+  preferences = prefs;
+  memset(&snapshot, 0, sizeof(snapshot));
+  restored = false;
+  restoredFromRtc = false;
+  flashPending = false;
+  lastSaveTime = 0;
+  phaseCount = 0;
+  flashWrites = 0;
+}
+
+// FNV-1a over the payload
+uint32_t BootFrame::checksumOf(const BootSnapshot* snap) {
+  const uint8_t* bytes = (const uint8_t*)snap + offsetof(BootSnapshot, emotion);
+  size_t length = sizeof(BootSnapshot) - offsetof(BootSnapshot, emotion);
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+bool BootFrame::isValid(const BootSnapshot* snap) {
+  return snap->magic == BOOT_FRAME_MAGIC && snap->checksum == checksumOf(snap);
+}
+
+bool BootFrame::restore() {
+  if (isValid(&rtcSnapshot)) {
+    snapshot = rtcSnapshot;
+    restored = true;
+    restoredFromRtc = true;
+    return true;
+  }
+
+  // Power-on: RTC memory holds noise, use the flash copy
+  preferences->begin("mochi", true);
+  size_t length = preferences->getBytes("boot_frame", &snapshot, sizeof(snapshot));
+  preferences->end();
+  if (length == sizeof(snapshot) && isValid(&snapshot)) {
+    rtcSnapshot = snapshot;
+    restored = true;
+    return true;
+  }
+
+  memset(&snapshot, 0, sizeof(snapshot));
+  return false;
+}
+
+void BootFrame::capture(const uint8_t* frame, uint8_t emotion, time_t now) {
+  bool changed = memcmp(snapshot.frame, frame, Panel::frameBytes) != 0 || snapshot.emotion != emotion;
+
+  snapshot.magic = BOOT_FRAME_MAGIC;
+  snapshot.emotion = emotion;
+  if (now >= BOOT_FRAME_MIN_TIME) {
+    snapshot.lastTime = now;
+  }
+  memcpy(snapshot.frame, frame, Panel::frameBytes);
+  snapshot.checksum = checksumOf(&snapshot);
+  rtcSnapshot = snapshot;
+
+  // The time alone moving on is not worth a flash write
+  if (changed) {
+    flashPending = true;
+  }
+}
+
+bool BootFrame::save(bool force) {
+  if (!flashPending) return false;
+  if (!force && flashWrites > 0 && millis() - lastSaveTime < BOOT_FRAME_SAVE_INTERVAL) return false;
+
+  preferences->begin("mochi", false);
+  preferences->putBytes("boot_frame", &snapshot, sizeof(snapshot));
+  preferences->end();
+  flashPending = false;
+  lastSaveTime = millis();
+  flashWrites++;
+  return true;
+}
+
+void BootFrame::markPhase(const char* name) {
+  if (phaseCount < BOOT_PHASES_MAX) {
+    phases[phaseCount].name = name;
+    phases[phaseCount].endMillis = millis();
+    phaseCount++;
+  }
+}
+
+void BootFrame::printReport() {
+  Serial.println("⏱️ Boot phases (ms since boot):");
+  unsigned long previous = 0;
+  for (int i = 0; i < phaseCount; i++) {
+    Serial.print("  ");
+    Serial.print(phases[i].name);
+    Serial.print(": +");
+    Serial.print(phases[i].endMillis - previous);
+    Serial.print(" -> ");
+    Serial.println(phases[i].endMillis);
+    previous = phases[i].endMillis;
+  }
+
+  Serial.print("  Boot frame: ");
+  if (!restored) {
+    Serial.println("none (first boot)");
+  } else {
+    Serial.print(restoredFromRtc ? "RTC memory" : "flash");
+    if (snapshot.lastTime > 0) {
+      struct tm lastSeen;
+      time_t last = (time_t)snapshot.lastTime;
+      localtime_r(&last, &lastSeen);
+      char timeStr[20];
+      strftime(timeStr, sizeof(timeStr), "%d/%m/%Y %H:%M", &lastSeen);
+      Serial.print(", last seen ");
+      Serial.print(timeStr);
+    }
+    Serial.println();
+  }
+}
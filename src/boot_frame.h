@@ -0,0 +1,87 @@
+/*
+ * Mochi Robot - Boot Frame
+ * Persists the last face/clock frame so the panel shows it right after power-on
+ *
+ * capture() keeps a snapshot (frame, emotion, wall-clock time) in RTC
+ * memory, which survives resets and deep sleep but not power loss, and
+ * marks it for the "mochi" NVS namespace. save() writes it to flash at
+ * most every BOOT_FRAME_SAVE_INTERVAL. restore() prefers the RTC copy and
+ * falls back to flash. Both copies carry a checksum.
+ *
+ * The boot phases of setup() are timed here too (markPhase/printReport).
+ */
+
+#ifndef BOOT_FRAME_H
+#define BOOT_FRAME_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <time.h>
+#include "display_geometry.h"
+
+#define BOOT_FRAME_MAGIC 0x4D4F4348         // "MOCH"
+#define BOOT_FRAME_SAVE_INTERVAL 600000     // Flash writes at most every 10 minutes
+#define BOOT_FRAME_CAPTURE_INTERVAL 5000    // How often main.cpp snapshots the panel
+#define BOOT_PHASES_MAX 12
+#define BOOT_FRAME_MIN_TIME 1577836800      // 2020-01-01: earlier time() values are not wall-clock
+
+struct BootSnapshot {
+  uint32_t magic;
+  uint32_t checksum; // Over everything after this field
+  uint8_t emotion;
+  uint8_t reserved[3];
+  int64_t lastTime;  // time() at capture, 0 if the clock was never synced
+  uint8_t frame[Panel::frameBytes];
+};
+
+class BootFrame {
+private:
+  struct Phase {
+    const char* name;
+    unsigned long endMillis;
+  };
+
+  Preferences* preferences;
+  BootSnapshot snapshot;
+  bool restored;
+  bool restoredFromRtc;
+  bool flashPending; // Captured since the last flash write
+  unsigned long lastSaveTime;
+  Phase phases[BOOT_PHASES_MAX];
+  int phaseCount;
+
+  // Statistics
+  unsigned long flashWrites;
+
+  static uint32_t checksumOf(const BootSnapshot* snap);
+  static bool isValid(const BootSnapshot* snap);
+
+public:
+  BootFrame(Preferences* prefs);
+
+  // Load the last snapshot (RTC first, then flash). False on first boot.
+  bool restore();
+  bool wasRestored() { return restored; }
+  bool wasRestoredFromRtc() { return restoredFromRtc; }
+
+  // Restored values (valid after restore() returned true)
+  const uint8_t* getFrame() { return snapshot.frame; }
+  uint8_t getEmotion() { return snapshot.emotion; }
+  time_t getLastTime() { return (time_t)snapshot.lastTime; }
+
+  // Record what is on the panel now; copies into RTC memory only
+  void capture(const uint8_t* frame, uint8_t emotion, time_t now);
+
+  // Write a pending capture to flash once the interval has passed (or now
+  // when forced, e.g. before sleep). Returns true if flash was written.
+  bool save(bool force = false);
+
+  // Boot timing: call after each setup() phase, then print the table
+  void markPhase(const char* name);
+  void printReport();
+
+  // Statistics
+  unsigned long getFlashWrites() { return flashWrites; }
+};
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Mochi Robot - Layer Compositor Implementation
+ */
+
+#include "compositor.h"
+#include "fb_primitives.h"
+#include "asset_blit.h"
+#include "assets_generated.h"
+
+Layer::Layer(uint8_t w, uint8_t h) : Adafruit_SSD1306(w, h, &Wire, -1) {
+  // Adafruit_SSD1306 frees the buffer in its destructor; begin() is never called
+  buffer = (uint8_t*)malloc(getByteCount());
+  if (buffer != nullptr) {
+    clearDisplay();
+  }
+}
+
+Compositor::Compositor()
+  : background(Panel::width, Panel::height), statusBar(STATUS_BAR_WIDTH, 8), statusMask(STATUS_BAR_WIDTH, 8) {
+  backgroundEnabled = false;
+  statusVisible = true;
+  statusDirty = true;
+  framePending = true;
+  wifiConnected = false;
+  bluetoothEnabled = false;
+  dataCached = false;
+  timeSynced = false;
+  statusRenders = 0;
+}
+
+void Compositor::markStatus() {
+  statusDirty = true;
+  if (statusVisible) framePending = true;
+}
+
+void Compositor::setBackgroundEnabled(bool enabled) {
+  if (enabled != backgroundEnabled) {
+    backgroundEnabled = enabled;
+    framePending = true;
+  }
+}
+
+void Compositor::setStatusVisible(bool visible) {
+  if (visible != statusVisible) {
+    statusVisible = visible;
+    framePending = true;
+  }
+}
+
+void Compositor::setWiFiConnected(bool connected) {
+  if (connected != wifiConnected) {
+    wifiConnected = connected;
+    markStatus();
+  }
+}
+
+void Compositor::setBluetoothEnabled(bool enabled) {
+  if (enabled != bluetoothEnabled) {
+    bluetoothEnabled = enabled;
+    markStatus();
+  }
+}
+
+void Compositor::setDataCached(bool cached) {
+  if (cached != dataCached) {
+    dataCached = cached;
+    markStatus();
+  }
+}
+
+void Compositor::setTimeSynced(bool synced) {
+  if (synced != timeSynced) {
+    timeSynced = synced;
+    markStatus();
+  }
+}
+
+void Compositor::renderStatus() {
+  statusBar.clearDisplay();
+  statusMask.clearDisplay();
+
+  // WiFi is always shown; the rest only when active
+  const PackedAsset* icons[4];
+  int count = 0;
+  icons[count++] = wifiConnected ? &ASSET_STATUS_WIFI_ON : &ASSET_STATUS_WIFI_OFF;
+  if (bluetoothEnabled) icons[count++] = &ASSET_STATUS_BT;
+  if (timeSynced) icons[count++] = &ASSET_STATUS_SYNC;
+  if (dataCached) icons[count++] = &ASSET_STATUS_CACHED;
+
+  int x = STATUS_BAR_WIDTH - 8;
+  for (int i = 0; i < count; i++) {
+    blitAsset(&statusBar, *icons[i], x, 0);
+    // Mask one extra column so icons stay readable over content
+    fbFillRect(&statusMask, x - 1, 0, 9, 8, SSD1306_WHITE);
+    x -= STATUS_ICON_PITCH;
+  }
+
+  statusDirty = false;
+  statusRenders++;
+}
+
+void Compositor::compose(const uint8_t* content, uint8_t* frame) {
+  if (content == nullptr || frame == nullptr) return;
+
+  if (frame != content) {
+    memcpy(frame, content, background.getByteCount());
+  }
+  if (backgroundEnabled && background.isValid()) {
+    fbOrBytes(frame, background.getBuffer(), background.getByteCount());
+  }
+
+  if (statusVisible && statusBar.isValid() && statusMask.isValid()) {
+    if (statusDirty) renderStatus();
+    uint8_t* strip = frame + STATUS_BAR_X; // Page 0
+    fbAndNotBytes(strip, statusMask.getBuffer(), STATUS_BAR_WIDTH);
+    fbOrBytes(strip, statusBar.getBuffer(), STATUS_BAR_WIDTH);
+  }
+
+  framePending = false;
+}
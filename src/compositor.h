@@ -0,0 +1,88 @@
+/*
+ * Mochi Robot - Layer Compositor
+ * Combines a static background, the content frame and a cached status bar
+ *
+ * The content layer is the display's own back buffer: screens draw into it
+ * as before. MochiDisplay::display() calls compose(), which writes content
+ * OR background into the outgoing frame and stamps the status bar into
+ * page 0 (clear under the mask, then OR the icons), a word at a time. The
+ * content layer itself is left untouched, so retained widgets under the
+ * bar survive. The status bar is only re-rendered when its inputs change.
+ */
+
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <Adafruit_SSD1306.h>
+#include "display_geometry.h"
+
+// Status bar: one page tall, right-aligned, 8x8 icons laid out right to left
+#define STATUS_BAR_WIDTH 40
+#define STATUS_BAR_X (Panel::width - STATUS_BAR_WIDTH)
+
+static_assert(STATUS_BAR_X % 4 == 0, "Status strip should start on a word boundary");
+#define STATUS_ICON_PITCH 10
+
+// Off-screen 1bpp bitmap in SSD1306 page order. Being an Adafruit_SSD1306,
+// it accepts GFX, FastFont, fb_primitives and blitAsset drawing.
+class Layer : public Adafruit_SSD1306 {
+public:
+  Layer(uint8_t w, uint8_t h);
+  size_t getByteCount() { return (size_t)WIDTH * ((HEIGHT + 7) / 8); }
+  // False if the buffer could not be allocated; such a layer must not be drawn into
+  bool isValid() { return buffer != nullptr; }
+};
+
+class Compositor {
+private:
+  Layer background;
+  Layer statusBar;  // STATUS_BAR_WIDTH x 8 strip
+  Layer statusMask; // Set where the strip hides the content below
+  bool backgroundEnabled;
+  bool statusVisible;
+  bool statusDirty;  // Inputs changed since the strip was rendered
+  bool framePending; // Output changed since the last compose()
+
+  // Status inputs
+  bool wifiConnected;
+  bool bluetoothEnabled;
+  bool dataCached;
+  bool timeSynced;
+
+  // Statistics
+  unsigned long statusRenders;
+
+  void renderStatus();
+  void markStatus();
+
+public:
+  Compositor();
+
+  // Static art: draw into the background once, then enable it
+  Adafruit_SSD1306* getBackground() { return &background; }
+  bool hasBackground() { return background.isValid(); }
+  void setBackgroundEnabled(bool enabled);
+  // The background was redrawn (animated art): present the next frame
+  void markBackground() { if (backgroundEnabled) framePending = true; }
+
+  // Status bar
+  void setStatusVisible(bool visible);
+  void setWiFiConnected(bool connected);
+  void setBluetoothEnabled(bool enabled);
+  void setDataCached(bool cached);
+  void setTimeSynced(bool synced);
+
+  // True when the layers changed and the next frame must be presented
+  // even if the content did not
+  bool needsCompose() { return framePending; }
+
+  // Combine the content layer with the others into a full frame; content
+  // and frame may be the same buffer for renderers that redraw everything
+  void compose(const uint8_t* content, uint8_t* frame);
+  void compose(Adafruit_SSD1306* target) { compose(target->getBuffer(), target->getBuffer()); }
+
+  // Statistics
+  unsigned long getStatusRenders() { return statusRenders; }
+};
+
+#endif
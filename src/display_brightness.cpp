@@ -3,6 +3,7 @@
  */
 
 #include "display_brightness.h"
+#include "fb_primitives.h"
 #include <Arduino.h>
 
 DisplayBrightness::DisplayBrightness(Adafruit_SSD1306* disp) {
@@ -10,15 +11,25 @@ DisplayBrightness::DisplayBrightness(Adafruit_SSD1306* disp) {
   normalContrast = 255; // Full brightness
   dimmedContrast = 10;  // Very dim (almost off)
   currentContrast = normalContrast;
+  appliedContrast = normalContrast;
   isDimmed = false;
   isDimming = false;
   isBrightening = false;
   dimStartTime = 0;
   dimDuration = 1000;
+  budgetMilliamps = POWER_DEFAULT_BUDGET_MA;
+  litAverage = 0;
+  powerCap = 255;
 }
 
 void DisplayBrightness::setBrightness(uint8_t contrast) {
   currentContrast = contrast;
+  applyContrast();
+}
+
+void DisplayBrightness::applyContrast() {
+  uint8_t contrast = currentContrast < powerCap ? currentContrast : powerCap;
+  appliedContrast = contrast;
   // SSD1306 contrast command (0x81)
   // Use Wire directly to send contrast command
   Wire.beginTransmission(0x3C); // SSD1306 I2C address
@@ -28,6 +39,44 @@ void DisplayBrightness::setBrightness(uint8_t contrast) {
   Wire.endTransmission();
 }
 
+void DisplayBrightness::trackFrame(const uint8_t* frame, size_t bytes) {
+  uint32_t lit = fbPopcount(frame, bytes);
+  // Exponential average, so one bright frame does not pump the contrast
+  litAverage = litAverage + lit - (litAverage >> POWER_AVERAGE_SHIFT);
+  
+  // Highest contrast whose pixel current fits what the base leaves over
+  uint8_t cap = 255;
+  uint32_t pixels = getLitPixels();
+  if (budgetMilliamps > 0 && pixels > 0) {
+    uint32_t budgetUa = (uint32_t)budgetMilliamps * 1000;
+    uint32_t spareUa = budgetUa > POWER_BASE_UA ? budgetUa - POWER_BASE_UA : 0;
+    uint64_t fit = (uint64_t)spareUa * 1000 * 255 / ((uint64_t)pixels * POWER_PIXEL_NA);
+    // Rounded down to whole steps so a slowly moving average does not
+    // send a contrast command every frame
+    fit &= ~(uint64_t)(POWER_CONTRAST_STEP - 1);
+    cap = fit >= 255 ? 255 : (fit < POWER_MIN_CONTRAST ? POWER_MIN_CONTRAST : (uint8_t)fit);
+  }
+  
+  // Only talk to the panel when the effective contrast changes
+  powerCap = cap;
+  uint8_t wanted = currentContrast < powerCap ? currentContrast : powerCap;
+  if (wanted != appliedContrast) {
+    applyContrast();
+  }
+}
+
+void DisplayBrightness::setCurrentBudget(uint16_t milliamps) {
+  budgetMilliamps = milliamps;
+  if (milliamps == 0) {
+    powerCap = 255;
+    applyContrast();
+  }
+}
+
+uint32_t DisplayBrightness::getEstimatedMicroamps() {
+  return POWER_BASE_UA + (uint64_t)getLitPixels() * POWER_PIXEL_NA * appliedContrast / 255 / 1000;
+}
+
 void DisplayBrightness::dim(unsigned long duration) {
   if (isDimmed) return; // Already dimmed
   
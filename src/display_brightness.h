@@ -1,6 +1,11 @@
 /*
  * Mochi Robot - Display Brightness Control
- * Handles OLED dimming for sleep mode
+ * Handles OLED dimming for sleep mode and the lit-pixel power limiter
+ *
+ * OLED current grows with lit pixels times contrast. trackFrame() counts
+ * the lit pixels of each presented frame into a running average; when
+ * that average at the requested contrast would exceed the current
+ * budget, the contrast sent to the panel is capped.
  */
 
 #ifndef DISPLAY_BRIGHTNESS_H
@@ -8,12 +13,22 @@
 
 #include <Adafruit_SSD1306.h>
 
+// Panel current model: base draw plus a per-pixel share at full contrast
+// (about 22 mA for an all-white 128x64 frame at contrast 255)
+#define POWER_BASE_UA 600
+#define POWER_PIXEL_NA 2700
+#define POWER_DEFAULT_BUDGET_MA 10
+#define POWER_MIN_CONTRAST 32    // The limiter never dims below this
+#define POWER_CONTRAST_STEP 4    // Cap granularity (power of two)
+#define POWER_AVERAGE_SHIFT 3    // Lit-pixel average: 1/8 per frame
+
 class DisplayBrightness {
 private:
   Adafruit_SSD1306* display;
   uint8_t normalContrast;
   uint8_t dimmedContrast;
-  uint8_t currentContrast;
+  uint8_t currentContrast; // Requested by dimming / setBrightness()
+  uint8_t appliedContrast; // Sent to the panel (capped by the power limiter)
   bool isDimmed;
   
   // Dimming animation
@@ -22,6 +37,13 @@ private:
   bool isDimming;
   bool isBrightening;
   
+  // Power limiter
+  uint16_t budgetMilliamps; // 0 disables the limiter
+  uint32_t litAverage;      // Lit pixels, scaled by 1 << POWER_AVERAGE_SHIFT
+  uint8_t powerCap;
+  
+  void applyContrast();
+  
 public:
   DisplayBrightness(Adafruit_SSD1306* disp);
   
@@ -39,6 +61,17 @@ public:
   
   // Check state
   bool getIsDimmed() { return isDimmed; }
+  
+  // Power limiter: feed every presented frame, keep the average under budget
+  void trackFrame(const uint8_t* frame, size_t bytes);
+  void setCurrentBudget(uint16_t milliamps);
+  uint16_t getCurrentBudget() { return budgetMilliamps; }
+  uint32_t getLitPixels() { return litAverage >> POWER_AVERAGE_SHIFT; }
+  uint8_t getAppliedContrast() { return appliedContrast; }
+  bool isPowerLimited() { return appliedContrast < currentContrast; }
+  
+  // Estimated panel current at the applied contrast
+  uint32_t getEstimatedMicroamps();
 };
 
 #endif
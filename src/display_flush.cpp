@@ -0,0 +1,230 @@
+/*
+ * Mochi Robot - Display Flush Implementation
+ */
+
+#include "display_flush.h"
+#include <Arduino.h>
+#include <Wire.h>
+
+// Largest I2C write the Wire library accepts in one transaction
+#ifdef I2C_BUFFER_LENGTH
+#define FLUSH_WIRE_MAX I2C_BUFFER_LENGTH
+#else
+#define FLUSH_WIRE_MAX 32
+#endif
+
+DisplayFlush::DisplayFlush(Adafruit_SSD1306* disp, uint8_t address) {
+  display = disp;
+  i2cAddress = address;
+  lastFrameValid = false;
+  scrolling = false;
+  bytesSent = 0;
+  bytesSaved = 0;
+  flushCount = 0;
+  statsWindowStart = 0;
+  windowBytesSaved = 0;
+  bytesSavedPerSecond = 0;
+  subframeBytesSent = 0;
+}
+
+// Calls fn(page, colStart, colEnd) for each run of changed columns,
+// bridging short unchanged gaps
+template<typename SpanFn>
+void DisplayFlush::forEachSpan(const uint8_t* shadow, const uint8_t* frame, SpanFn fn) {
+  for (uint8_t page = 0; page < FLUSH_PAGES; page++) {
+    const uint8_t* row = frame + page * FLUSH_WIDTH;
+    const uint8_t* shown = shadow + page * FLUSH_WIDTH;
+    int col = 0;
+
+    while (col < FLUSH_WIDTH) {
+      // Skip columns that already match the panel
+      while (col < FLUSH_WIDTH && row[col] == shown[col]) col++;
+      if (col >= FLUSH_WIDTH) break;
+
+      // Grow the span, bridging short unchanged gaps
+      int start = col;
+      int end = col;
+      int gap = 0;
+      while (col < FLUSH_WIDTH) {
+        if (row[col] != shown[col]) {
+          end = col;
+          gap = 0;
+        } else if (++gap > SPAN_MERGE_GAP) {
+          break;
+        }
+        col++;
+      }
+      fn(page, start, end);
+    }
+  }
+}
+
+void DisplayFlush::flush() {
+  flush(display->getBuffer());
+}
+
+void DisplayFlush::flush(const uint8_t* buffer) {
+  if (buffer == nullptr) {
+    return;
+  }
+  updateStats(sendChanges(buffer));
+}
+
+void DisplayFlush::flushSubframe(const uint8_t* buffer) {
+  if (buffer == nullptr) {
+    return;
+  }
+  subframeBytesSent += sendChanges(buffer);
+}
+
+unsigned long DisplayFlush::sendChanges(const uint8_t* buffer) {
+  // Adafruit transfers leave the bus at their clkAfter (100 kHz by default)
+  Wire.setClock(FLUSH_I2C_HZ);
+  stopScroll();
+  unsigned long sentNow = 0;
+
+  if (!lastFrameValid) {
+    // Panel contents unknown - send the whole frame once
+    sendWindow(0, FLUSH_PAGES - 1, 0, FLUSH_WIDTH - 1, buffer, FLUSH_FRAME_BYTES);
+    memcpy(lastFrame, buffer, FLUSH_FRAME_BYTES);
+    lastFrameValid = true;
+    sentNow = FLUSH_FRAME_BYTES;
+  } else {
+    forEachSpan(lastFrame, buffer, [&](uint8_t page, int start, int end) {
+      const uint8_t* row = buffer + page * FLUSH_WIDTH;
+      sendSpan(page, start, end, row + start);
+      memcpy(lastFrame + page * FLUSH_WIDTH + start, row + start, end - start + 1);
+      sentNow += end - start + 1;
+    });
+  }
+  return sentNow;
+}
+
+unsigned long DisplayFlush::wireBytes(const uint8_t* shown, const uint8_t* frame) {
+  unsigned long bytes = 0;
+  forEachSpan(shown, frame, [&](uint8_t /*page*/, int start, int end) {
+    unsigned long count = end - start + 1;
+    unsigned long chunks = (count + FLUSH_WIRE_MAX - 2) / (FLUSH_WIRE_MAX - 1);
+    bytes += 2 + 6;               // Address, command control byte, window commands
+    bytes += count + chunks * 2;  // Data, plus address and control byte per chunk
+  });
+  return bytes;
+}
+
+void DisplayFlush::transition(const uint8_t* frame, TransitionType type) {
+  if (frame == nullptr) {
+    return;
+  }
+  Wire.setClock(FLUSH_I2C_HZ);
+  stopScroll();
+  if (type == TRANSITION_NONE || (!lastFrameValid && type != TRANSITION_SCREENSAVER)) {
+    flush(frame); // Nothing known on the panel to slide away
+    return;
+  }
+
+  ScreenTransition plan(type);
+  TransitionStep step;
+  unsigned long sentNow = 0;
+  while (plan.next(step)) {
+    if (step.scroll != SCROLL_KEEP) {
+      sendScroll(step.scroll);
+    }
+    if (step.startLine >= 0) {
+      uint8_t command = SSD1306_SETSTARTLINE | step.startLine;
+      sendCommands(&command, 1);
+    }
+    if (step.ramPage >= 0) {
+      sendWindow(step.ramPage, step.ramPage, 0, FLUSH_WIDTH - 1,
+                 frame + step.framePage * FLUSH_WIDTH, FLUSH_WIDTH);
+      sentNow += FLUSH_WIDTH;
+    }
+    if (step.holdMs > 0) {
+      delay(step.holdMs); // The panel animates on its own meanwhile
+    }
+  }
+
+  memcpy(lastFrame, frame, FLUSH_FRAME_BYTES);
+  updateStats(sentNow);
+}
+
+void DisplayFlush::sendScroll(uint8_t scroll) {
+  scrolling = (scroll != SCROLL_STOP);
+  if (scroll == SCROLL_STOP) {
+    const uint8_t stop = SSD1306_DEACTIVATE_SCROLL;
+    sendCommands(&stop, 1);
+    return;
+  }
+  if (scroll == SCROLL_START_DIAGONAL) {
+    // Rows wrap inside the vertical scroll area, set to the whole panel
+    const uint8_t diagonal[] = {
+      SSD1306_SET_VERTICAL_SCROLL_AREA, 0x00, (uint8_t)Panel::height,
+      SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL,
+      0x00, 0, SCREENSAVER_SCROLL_INTERVAL, (uint8_t)(FLUSH_PAGES - 1), SCREENSAVER_SCROLL_OFFSET,
+      SSD1306_ACTIVATE_SCROLL
+    };
+    sendCommands(diagonal, sizeof(diagonal));
+    return;
+  }
+  const uint8_t start[] = {
+    (uint8_t)(scroll == SCROLL_START_LEFT ? SSD1306_LEFT_HORIZONTAL_SCROLL : SSD1306_RIGHT_HORIZONTAL_SCROLL),
+    0x00, 0, TRANSITION_SCROLL_INTERVAL, (uint8_t)(FLUSH_PAGES - 1), 0x00, 0xFF,
+    SSD1306_ACTIVATE_SCROLL
+  };
+  sendCommands(start, sizeof(start));
+}
+
+// The controller needs its RAM rewritten once a scroll stops
+void DisplayFlush::stopScroll() {
+  if (scrolling) {
+    sendScroll(SCROLL_STOP);
+    lastFrameValid = false;
+  }
+}
+
+void DisplayFlush::sendCommands(const uint8_t* commands, uint8_t count) {
+  Wire.beginTransmission(i2cAddress);
+  Wire.write(0x00); // Command stream
+  Wire.write(commands, count);
+  Wire.endTransmission();
+}
+
+void DisplayFlush::sendWindow(uint8_t pageStart, uint8_t pageEnd, uint8_t colStart, uint8_t colEnd,
+                              const uint8_t* data, uint16_t count) {
+  // Window the GDDRAM write to a page and column range
+  const uint8_t window[] = {
+    SSD1306_PAGEADDR, pageStart, pageEnd,
+    SSD1306_COLUMNADDR, colStart, colEnd
+  };
+  sendCommands(window, sizeof(window));
+
+  uint16_t remaining = count;
+  while (remaining > 0) {
+    uint16_t chunk = min((uint16_t)(FLUSH_WIRE_MAX - 1), remaining);
+    Wire.beginTransmission(i2cAddress);
+    Wire.write(0x40); // Data stream
+    Wire.write(data, chunk);
+    Wire.endTransmission();
+    data += chunk;
+    remaining -= chunk;
+  }
+}
+
+void DisplayFlush::sendSpan(uint8_t page, uint8_t colStart, uint8_t colEnd, const uint8_t* data) {
+  sendWindow(page, page, colStart, colEnd, data, colEnd - colStart + 1);
+}
+
+void DisplayFlush::updateStats(unsigned long sentNow) {
+  // Transitions on 128x32 panels write the frame twice
+  unsigned long saved = (sentNow < FLUSH_FRAME_BYTES) ? FLUSH_FRAME_BYTES - sentNow : 0;
+  bytesSent += sentNow;
+  bytesSaved += saved;
+  windowBytesSaved += saved;
+  flushCount++;
+
+  unsigned long now = millis();
+  if (now - statsWindowStart >= 1000) {
+    bytesSavedPerSecond = windowBytesSaved * 1000 / (now - statsWindowStart);
+    windowBytesSaved = 0;
+    statsWindowStart = now;
+  }
+}
@@ -0,0 +1,95 @@
+/*
+ * Mochi Robot - Display Flush (Dirty Page Tracking)
+ * Sends only the changed parts of the SSD1306 framebuffer over I2C
+ */
+
+#ifndef DISPLAY_FLUSH_H
+#define DISPLAY_FLUSH_H
+
+#include <Adafruit_SSD1306.h>
+#include "display_geometry.h"
+#include "screen_transition.h"
+
+// Panel geometry tracked by the flush layer
+#define FLUSH_WIDTH       Panel::width
+#define FLUSH_PAGES       Panel::pages
+#define FLUSH_FRAME_BYTES Panel::frameBytes
+
+// I2C clock for frame data, set at the start of every flush and transition
+// (Adafruit drops the bus to 100 kHz after its own commands by default)
+#define FLUSH_I2C_HZ 400000
+
+class DisplayFlush {
+private:
+  Adafruit_SSD1306* display;
+  uint8_t i2cAddress;
+
+  // Copy of the frame the panel is currently showing
+  uint8_t lastFrame[FLUSH_FRAME_BYTES];
+  bool lastFrameValid;
+  bool scrolling; // A hardware scroll is running (screensaver)
+
+  // Statistics
+  unsigned long bytesSent;
+  unsigned long bytesSaved;
+  unsigned long flushCount;
+  unsigned long statsWindowStart;
+  unsigned long windowBytesSaved;
+  unsigned long bytesSavedPerSecond;
+  unsigned long subframeBytesSent; // Gray subframes, kept out of the frame stats
+
+  // Changed runs closer than this are merged (a new window costs ~8 bytes)
+  static const uint8_t SPAN_MERGE_GAP = 8;
+
+  void sendCommands(const uint8_t* commands, uint8_t count);
+  void sendWindow(uint8_t pageStart, uint8_t pageEnd, uint8_t colStart, uint8_t colEnd,
+                  const uint8_t* data, uint16_t count);
+  void sendSpan(uint8_t page, uint8_t colStart, uint8_t colEnd, const uint8_t* data);
+  template<typename SpanFn>
+  static void forEachSpan(const uint8_t* shadow, const uint8_t* frame, SpanFn fn);
+  void sendScroll(uint8_t scroll);
+  void stopScroll();
+  unsigned long sendChanges(const uint8_t* frame); // Diff flush; returns data bytes sent
+  void updateStats(unsigned long sentNow);
+
+public:
+  DisplayFlush(Adafruit_SSD1306* disp, uint8_t address = 0x3C);
+
+  // Push the display buffer to the panel, sending only changed spans
+  void flush();
+
+  // Same, from a caller-owned frame (e.g. MochiDisplay's front buffer)
+  void flush(const uint8_t* frame);
+
+  // Same for a grayscale subframe: its bytes only count towards
+  // getSubframeBytesSent(), not the per-frame statistics
+  void flushSubframe(const uint8_t* frame);
+
+  // Show a frame through a hardware slide/scroll (see screen_transition.h);
+  // blocks for the transition, sleeping between steps
+  void transition(const uint8_t* frame, TransitionType type);
+
+  // Bus cost of a diff flush from `shown` to `frame`: bytes on the wire
+  // (data plus window commands and transaction headers) and the time they
+  // take at FLUSH_I2C_HZ
+  static unsigned long wireBytes(const uint8_t* shown, const uint8_t* frame);
+  static unsigned long busMicros(unsigned long bytes) {
+    return (unsigned long)((uint64_t)bytes * 9 * 1000000 / FLUSH_I2C_HZ); // 8 bits + ACK
+  }
+
+  // Forget what the panel shows (e.g. after another component wrote to it)
+  void invalidate() { lastFrameValid = false; }
+
+  // True while the panel animates on its own (TRANSITION_SCREENSAVER);
+  // the next flush or transition stops it and rewrites the whole frame
+  bool isScrolling() { return scrolling; }
+
+  // Statistics
+  unsigned long getBytesSent() { return bytesSent; }
+  unsigned long getBytesSaved() { return bytesSaved; }
+  unsigned long getFlushCount() { return flushCount; }
+  unsigned long getBytesSavedPerSecond() { return bytesSavedPerSecond; }
+  unsigned long getSubframeBytesSent() { return subframeBytesSent; }
+};
+
+#endif
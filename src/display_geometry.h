@@ -0,0 +1,53 @@
+/*
+ * Mochi Robot - Display Geometry
+ * Compile-time panel size and orientation
+ *
+ * Select the panel with build flags, e.g. -DMOCHI_PANEL_HEIGHT=32 for a
+ * 128x32 module. Buffers, flush windows, centering and screen layouts all
+ * derive from Panel, so another panel is a rebuild rather than a runtime
+ * branch.
+ */
+
+#ifndef DISPLAY_GEOMETRY_H
+#define DISPLAY_GEOMETRY_H
+
+#ifndef MOCHI_PANEL_WIDTH
+#define MOCHI_PANEL_WIDTH 128
+#endif
+
+#ifndef MOCHI_PANEL_HEIGHT
+#define MOCHI_PANEL_HEIGHT 64
+#endif
+
+// Adafruit GFX units: 0 = normal, 2 = 180 degrees (done by the controller,
+// so the page-order fast paths still see an unrotated buffer)
+#ifndef MOCHI_PANEL_ROTATION
+#define MOCHI_PANEL_ROTATION 0
+#endif
+
+template <int W, int H, int ROT>
+struct DisplayGeometry {
+  static_assert(W > 0 && W <= 128, "SSD1306 drives at most 128 columns");
+  static_assert(H == 32 || H == 64, "SSD1306 modules are 32 or 64 rows");
+  static_assert(ROT == 0 || ROT == 2, "Screens are laid out in landscape: rotation 0 or 2");
+
+  static constexpr int width = W;
+  static constexpr int height = H;
+  static constexpr int pages = H / 8;
+  static constexpr int frameBytes = W * pages;
+  static constexpr int centerX = W / 2;
+  static constexpr int centerY = H / 2;
+  static constexpr bool flipped = (ROT == 2);
+
+  // 128x32 modules use the squeezed screen layouts
+  static constexpr bool compact = (H < 64);
+
+  // Pick a layout value for the full or the compact panel
+  static constexpr int layout(int full, int compactValue) {
+    return compact ? compactValue : full;
+  }
+};
+
+typedef DisplayGeometry<MOCHI_PANEL_WIDTH, MOCHI_PANEL_HEIGHT, MOCHI_PANEL_ROTATION> Panel;
+
+#endif
@@ -4,19 +4,23 @@
  */
 
 #include "emoji_drawer.h"
-#include <math.h>
+#include "arc_raster.h"
+#include "fb_primitives.h"
 
 EmojiDrawer::EmojiDrawer(Adafruit_SSD1306* disp) {
   display = disp;
-  centerX = 64;
-  centerY = 32;
+  centerX = Panel::centerX;
+  centerY = Panel::centerY;
   faceSize = 40;
-  lastBlink = 0;
   eyesOpen = true;
-  animationFrame = 0;
+  animationTick = 0;
+  spriteCache = nullptr;
 }
 
 void EmojiDrawer::setPosition(int x, int y) {
+  if ((x != centerX || y != centerY) && spriteCache != nullptr) {
+    spriteCache->clear(); // Cached sprites were rendered at the old position
+  }
   centerX = x;
   centerY = y;
 }
@@ -27,42 +31,27 @@ void EmojiDrawer::setSize(int size) {
 
 void EmojiDrawer::drawCircle(int x, int y, int radius, bool fill) {
   if (fill) {
-    display->fillCircle(x, y, radius, SSD1306_WHITE);
+    fbFillCircle(display, x, y, radius, SSD1306_WHITE);
   } else {
     display->drawCircle(x, y, radius, SSD1306_WHITE);
   }
 }
 
-void EmojiDrawer::drawArc(int x, int y, int radiusX, int radiusY, int startAngle, int endAngle) {
-  // Draw an arc by plotting points along the ellipse
+void EmojiDrawer::drawArc(int x, int y, int radiusX, int radiusY, int startAngle, int endAngle, int thickness) {
+  // Integer midpoint ellipse, each pixel plotted once and no gaps on large radii
   // Angles are in degrees, 0 is right, 90 is down
-  int steps = abs(endAngle - startAngle) / 2;
-  if (steps < 1) steps = 1;
-  
-  for (int i = 0; i <= steps; i++) {
-    int angle = startAngle + (endAngle - startAngle) * i / steps;
-    float rad = angle * PI / 180.0;
-    int px = x + radiusX * cos(rad);
-    int py = y + radiusY * sin(rad);
-    display->drawPixel(px, py, SSD1306_WHITE);
-    
-    // Draw a few pixels around for thickness
-    if (i > 0 && i < steps) {
-      display->drawPixel(px + 1, py, SSD1306_WHITE);
-      display->drawPixel(px, py + 1, SSD1306_WHITE);
-    }
-  }
+  drawEllipseArc(display, x, y, radiusX, radiusY, startAngle, endAngle, thickness, SSD1306_WHITE);
 }
 
 void EmojiDrawer::drawEye(int x, int y, int size, bool open) {
   if (open) {
     // Open eye - draw circle
-    display->fillCircle(x, y, size, SSD1306_WHITE);
+    fbFillCircle(display, x, y, size, SSD1306_WHITE);
     // Pupil
-    display->fillCircle(x, y, size/3, SSD1306_BLACK);
+    fbFillCircle(display, x, y, size/3, SSD1306_BLACK);
   } else {
     // Closed eye - draw line
-    display->drawLine(x - size, y, x + size, y, SSD1306_WHITE);
+    fbDrawHLine(display, x - size, y, 2 * size + 1, SSD1306_WHITE);
   }
 }
 
@@ -79,7 +68,7 @@ void EmojiDrawer::drawMouth(int x, int y, int width, int type) {
       display->drawCircle(x, y, width/2, SSD1306_WHITE);
       break;
     case 3: // Neutral line
-      display->drawLine(x - width/2, y, x + width/2, y, SSD1306_WHITE);
+      fbDrawHLine(display, x - width/2, y, width/2 * 2 + 1, SSD1306_WHITE);
       break;
   }
 }
@@ -91,18 +80,8 @@ void EmojiDrawer::drawEyebrow(int x, int y, int width, bool angry) {
     display->drawLine(x, y - 3, x + width/2, y, SSD1306_WHITE);
   } else {
     // Normal eyebrows
-    display->drawLine(x - width/2, y, x + width/2, y, SSD1306_WHITE);
-  }
-}
-
-void EmojiDrawer::updateAnimation() {
-  // Handle blinking animation
-  unsigned long now = millis();
-  if (now - lastBlink > 3000) { // Blink every 3 seconds
-    eyesOpen = !eyesOpen;
-    lastBlink = now;
+    fbDrawHLine(display, x - width/2, y, width/2 * 2 + 1, SSD1306_WHITE);
   }
-  animationFrame++;
 }
 
 // ========== EMOJI DRAWING FUNCTIONS ==========
@@ -134,8 +113,8 @@ void EmojiDrawer::drawSad() {
   drawEye(centerX + eyeSpacing, eyeY, 4, true);
   
   // Tears
-  display->fillCircle(centerX - eyeSpacing, eyeY + 6, 2, SSD1306_WHITE);
-  display->fillCircle(centerX + eyeSpacing, eyeY + 6, 2, SSD1306_WHITE);
+  fbFillCircle(display, centerX - eyeSpacing, eyeY + 6, 2, SSD1306_WHITE);
+  fbFillCircle(display, centerX + eyeSpacing, eyeY + 6, 2, SSD1306_WHITE);
   
   // Sad frown
   drawArc(centerX, centerY + 12, 10, 5, 180, 360);
@@ -157,12 +136,12 @@ void EmojiDrawer::drawAngry() {
   drawEye(centerX + eyeSpacing, eyeY, 3, true);
   
   // Angry mouth
-  display->drawLine(centerX - 8, centerY + 10, centerX + 8, centerY + 10, SSD1306_WHITE);
+  fbDrawHLine(display, centerX - 8, centerY + 10, 17, SSD1306_WHITE);
   
   // Steam (optional animation)
-  if (animationFrame % 20 < 10) {
-    display->fillCircle(centerX - 10, centerY - faceSize/2 - 2, 2, SSD1306_WHITE);
-    display->fillCircle(centerX + 10, centerY - faceSize/2 - 2, 2, SSD1306_WHITE);
+  if (animationTick % 20 < 10) {
+    fbFillCircle(display, centerX - 10, centerY - faceSize/2 - 2, 2, SSD1306_WHITE);
+    fbFillCircle(display, centerX + 10, centerY - faceSize/2 - 2, 2, SSD1306_WHITE);
   }
 }
 
@@ -176,8 +155,8 @@ void EmojiDrawer::drawSurprised() {
   // Wide open eyes
   drawCircle(centerX - eyeSpacing, eyeY, 6, false);
   drawCircle(centerX + eyeSpacing, eyeY, 6, false);
-  display->fillCircle(centerX - eyeSpacing, eyeY, 3, SSD1306_WHITE);
-  display->fillCircle(centerX + eyeSpacing, eyeY, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX - eyeSpacing, eyeY, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX + eyeSpacing, eyeY, 3, SSD1306_WHITE);
   
   // Surprised O mouth
   drawCircle(centerX, centerY + 10, 6, false);
@@ -192,21 +171,21 @@ void EmojiDrawer::drawLove() {
   
   // Heart eyes
   // Left heart
-  display->fillCircle(centerX - eyeSpacing - 2, eyeY, 3, SSD1306_WHITE);
-  display->fillCircle(centerX - eyeSpacing + 2, eyeY, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX - eyeSpacing - 2, eyeY, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX - eyeSpacing + 2, eyeY, 3, SSD1306_WHITE);
   display->fillTriangle(centerX - eyeSpacing, eyeY + 4, centerX - eyeSpacing - 4, eyeY, centerX - eyeSpacing + 4, eyeY, SSD1306_WHITE);
   
   // Right heart
-  display->fillCircle(centerX + eyeSpacing - 2, eyeY, 3, SSD1306_WHITE);
-  display->fillCircle(centerX + eyeSpacing + 2, eyeY, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX + eyeSpacing - 2, eyeY, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX + eyeSpacing + 2, eyeY, 3, SSD1306_WHITE);
   display->fillTriangle(centerX + eyeSpacing, eyeY + 4, centerX + eyeSpacing - 4, eyeY, centerX + eyeSpacing + 4, eyeY, SSD1306_WHITE);
   
   // Happy smile
   drawArc(centerX, centerY + 8, 12, 6, 0, 180);
   
   // Blush (optional)
-  display->fillCircle(centerX - 18, centerY + 2, 3, SSD1306_WHITE);
-  display->fillCircle(centerX + 18, centerY + 2, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX - 18, centerY + 2, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX + 18, centerY + 2, 3, SSD1306_WHITE);
 }
 
 void EmojiDrawer::drawSleepy() {
@@ -221,7 +200,7 @@ void EmojiDrawer::drawSleepy() {
   drawArc(centerX + eyeSpacing, eyeY, 4, 2, 0, 180);
   
   // Z's floating up (animation)
-  int zOffset = (animationFrame % 30) - 15;
+  int zOffset = (animationTick % 30) - 15;
   display->drawLine(centerX - 5, centerY - faceSize/2 + zOffset, centerX - 2, centerY - faceSize/2 - 2 + zOffset, SSD1306_WHITE);
   display->drawLine(centerX - 2, centerY - faceSize/2 - 2 + zOffset, centerX + 1, centerY - faceSize/2 + zOffset, SSD1306_WHITE);
   display->drawLine(centerX + 1, centerY - faceSize/2 + zOffset, centerX + 4, centerY - faceSize/2 - 2 + zOffset, SSD1306_WHITE);
@@ -235,12 +214,12 @@ void EmojiDrawer::drawThinking() {
   drawCircle(centerX, centerY, faceSize/2, false);
   
   // Eyes looking up/thinking
-  display->fillCircle(centerX - eyeSpacing, eyeY - 2, 3, SSD1306_WHITE);
-  display->fillCircle(centerX + eyeSpacing, eyeY - 2, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX - eyeSpacing, eyeY - 2, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX + eyeSpacing, eyeY - 2, 3, SSD1306_WHITE);
   
   // Hand on chin (simplified)
-  display->drawLine(centerX, centerY + 5, centerX, centerY + 15, SSD1306_WHITE);
-  display->fillCircle(centerX, centerY + 15, 4, SSD1306_WHITE);
+  fbDrawVLine(display, centerX, centerY + 5, 11, SSD1306_WHITE);
+  fbFillCircle(display, centerX, centerY + 15, 4, SSD1306_WHITE);
   
   // Thought bubble
   display->drawCircle(centerX + 15, centerY - 10, 5, SSD1306_WHITE);
@@ -259,33 +238,33 @@ void EmojiDrawer::drawLaughing() {
   drawArc(centerX + eyeSpacing, eyeY, 5, 2, 0, 180);
   
   // Tears of joy
-  display->fillCircle(centerX - eyeSpacing, eyeY + 4, 2, SSD1306_WHITE);
-  display->fillCircle(centerX + eyeSpacing, eyeY + 4, 2, SSD1306_WHITE);
+  fbFillCircle(display, centerX - eyeSpacing, eyeY + 4, 2, SSD1306_WHITE);
+  fbFillCircle(display, centerX + eyeSpacing, eyeY + 4, 2, SSD1306_WHITE);
   
   // Wide open laughing mouth
-  display->fillRect(centerX - 10, centerY + 8, 20, 8, SSD1306_WHITE);
+  fbFillRect(display, centerX - 10, centerY + 8, 20, 8, SSD1306_WHITE);
   // Teeth
   for (int i = -8; i <= 8; i += 4) {
-    display->drawLine(centerX + i, centerY + 8, centerX + i, centerY + 12, SSD1306_BLACK);
+    fbDrawVLine(display, centerX + i, centerY + 8, 5, SSD1306_BLACK);
   }
 }
 
 void EmojiDrawer::drawPetHappy() {
   drawHappy();
   // Add some extra sparkle
-  if (animationFrame % 10 < 5) {
-    display->fillCircle(centerX - 20, centerY - 15, 1, SSD1306_WHITE);
-    display->fillCircle(centerX + 20, centerY - 15, 1, SSD1306_WHITE);
+  if (animationTick % 10 < 5) {
+    fbFillCircle(display, centerX - 20, centerY - 15, 1, SSD1306_WHITE);
+    fbFillCircle(display, centerX + 20, centerY - 15, 1, SSD1306_WHITE);
   }
 }
 
 void EmojiDrawer::drawPetLove() {
   drawLove();
   // Extra hearts around
-  int heartFrame = animationFrame % 20;
+  int heartFrame = animationTick % 20;
   if (heartFrame < 10) {
-    display->fillCircle(centerX - 25, centerY - 20, 2, SSD1306_WHITE);
-    display->fillCircle(centerX + 25, centerY - 20, 2, SSD1306_WHITE);
+    fbFillCircle(display, centerX - 25, centerY - 20, 2, SSD1306_WHITE);
+    fbFillCircle(display, centerX + 25, centerY - 20, 2, SSD1306_WHITE);
   }
 }
 
@@ -297,8 +276,8 @@ void EmojiDrawer::drawPetAnnoyed() {
   drawCircle(centerX, centerY, faceSize/2, false);
   
   // Annoyed eyes (looking away)
-  display->fillCircle(centerX - eyeSpacing - 2, eyeY, 3, SSD1306_WHITE);
-  display->fillCircle(centerX + eyeSpacing + 2, eyeY, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX - eyeSpacing - 2, eyeY, 3, SSD1306_WHITE);
+  fbFillCircle(display, centerX + eyeSpacing + 2, eyeY, 3, SSD1306_WHITE);
   
   // Slight frown
   drawArc(centerX, centerY + 10, 8, 3, 180, 360);
@@ -316,11 +295,11 @@ void EmojiDrawer::drawEating() {
   drawEye(centerX + eyeSpacing, eyeY, 4, eyesOpen);
   
   // Eating mouth (chewing animation)
-  int mouthFrame = animationFrame % 12;
+  int mouthFrame = animationTick % 12;
   if (mouthFrame < 6) {
-    display->fillRect(centerX - 8, centerY + 8, 16, 6, SSD1306_WHITE);
+    fbFillRect(display, centerX - 8, centerY + 8, 16, 6, SSD1306_WHITE);
   } else {
-    display->fillRect(centerX - 6, centerY + 8, 12, 6, SSD1306_WHITE);
+    fbFillRect(display, centerX - 6, centerY + 8, 12, 6, SSD1306_WHITE);
   }
 }
 
@@ -339,8 +318,8 @@ void EmojiDrawer::drawHungry() {
   display->drawCircle(centerX, centerY + 10, 5, SSD1306_WHITE);
   
   // Fork/spoon icon (simplified)
-  display->drawLine(centerX + 20, centerY - 5, centerX + 20, centerY + 5, SSD1306_WHITE);
-  display->drawLine(centerX + 18, centerY - 5, centerX + 22, centerY - 5, SSD1306_WHITE);
+  fbDrawVLine(display, centerX + 20, centerY - 5, 11, SSD1306_WHITE);
+  fbDrawHLine(display, centerX + 18, centerY - 5, 5, SSD1306_WHITE);
 }
 
 void EmojiDrawer::drawFull() {
@@ -370,11 +349,11 @@ void EmojiDrawer::drawThrowUp() {
   drawEye(centerX + eyeSpacing, eyeY, 4, true);
   
   // Open mouth with "vomit" (green would be ideal but we use white)
-  display->fillRect(centerX - 6, centerY + 8, 12, 10, SSD1306_WHITE);
+  fbFillRect(display, centerX - 6, centerY + 8, 12, 10, SSD1306_WHITE);
   // Vomit particles
   for (int i = 0; i < 5; i++) {
-    int offset = (animationFrame + i * 3) % 15;
-    display->fillCircle(centerX - 10 + i * 5, centerY + 18 + offset, 2, SSD1306_WHITE);
+    int offset = (animationTick + i * 3) % 15;
+    fbFillCircle(display, centerX - 10 + i * 5, centerY + 18 + offset, 2, SSD1306_WHITE);
   }
 }
 
@@ -386,24 +365,24 @@ void EmojiDrawer::drawStarving() {
   drawCircle(centerX, centerY, faceSize/2 - 2, false);
   
   // Weak eyes
-  display->drawLine(centerX - eyeSpacing - 3, eyeY, centerX - eyeSpacing + 3, eyeY, SSD1306_WHITE);
-  display->drawLine(centerX + eyeSpacing - 3, eyeY, centerX + eyeSpacing + 3, eyeY, SSD1306_WHITE);
+  fbDrawHLine(display, centerX - eyeSpacing - 3, eyeY, 7, SSD1306_WHITE);
+  fbDrawHLine(display, centerX + eyeSpacing - 3, eyeY, 7, SSD1306_WHITE);
   
   // Weak mouth
-  display->drawLine(centerX - 4, centerY + 10, centerX + 4, centerY + 10, SSD1306_WHITE);
+  fbDrawHLine(display, centerX - 4, centerY + 10, 9, SSD1306_WHITE);
   
   // Skull crossbones (simplified)
-  display->drawLine(centerX - 15, centerY - 20, centerX + 15, centerY - 20, SSD1306_WHITE);
-  display->drawLine(centerX, centerY - 25, centerX, centerY - 15, SSD1306_WHITE);
+  fbDrawHLine(display, centerX - 15, centerY - 20, 31, SSD1306_WHITE);
+  fbDrawVLine(display, centerX, centerY - 25, 11, SSD1306_WHITE);
 }
 
 void EmojiDrawer::drawCrying() {
   drawSad();
   // Extra tears
   for (int i = 0; i < 3; i++) {
-    int tearY = centerY - 5 + (animationFrame + i * 5) % 20;
-    display->fillCircle(centerX - 12, tearY, 1, SSD1306_WHITE);
-    display->fillCircle(centerX + 12, tearY, 1, SSD1306_WHITE);
+    int tearY = centerY - 5 + (animationTick + i * 5) % 20;
+    fbFillCircle(display, centerX - 12, tearY, 1, SSD1306_WHITE);
+    fbFillCircle(display, centerX + 12, tearY, 1, SSD1306_WHITE);
   }
 }
 
@@ -419,7 +398,7 @@ void EmojiDrawer::drawSleeping() {
   drawArc(centerX + eyeSpacing, eyeY, 5, 2, 0, 180);
   
   // Z's floating
-  int zOffset = (animationFrame % 40) - 20;
+  int zOffset = (animationTick % 40) - 20;
   for (int i = 0; i < 3; i++) {
     int zX = centerX - 10 + i * 10;
     int zY = centerY - faceSize/2 + zOffset + i * 5;
@@ -441,11 +420,11 @@ void EmojiDrawer::drawSick() {
   drawEye(centerX + eyeSpacing, eyeY, 4, true);
   
   // Thermometer (simplified)
-  display->drawLine(centerX + 18, centerY - 15, centerX + 18, centerY - 5, SSD1306_WHITE);
-  display->fillRect(centerX + 17, centerY - 15, 3, 5, SSD1306_WHITE);
+  fbDrawVLine(display, centerX + 18, centerY - 15, 11, SSD1306_WHITE);
+  fbFillRect(display, centerX + 17, centerY - 15, 3, 5, SSD1306_WHITE);
   
   // Weak mouth
-  display->drawLine(centerX - 6, centerY + 10, centerX + 6, centerY + 10, SSD1306_WHITE);
+  fbDrawHLine(display, centerX - 6, centerY + 10, 13, SSD1306_WHITE);
 }
 
 void EmojiDrawer::drawNeutral() {
@@ -460,12 +439,43 @@ void EmojiDrawer::drawNeutral() {
   drawEye(centerX + eyeSpacing, eyeY, 4, eyesOpen);
   
   // Neutral mouth
-  display->drawLine(centerX - 8, centerY + 10, centerX + 8, centerY + 10, SSD1306_WHITE);
+  fbDrawHLine(display, centerX - 8, centerY + 10, 17, SSD1306_WHITE);
 }
 
-// Main drawing function
-void EmojiDrawer::drawEmoji(EmojiType type, int frame) {
-  animationFrame = frame;
+AnimPhase EmojiDrawer::getFacePhase(EmojiType type) {
+  // Must cover everything the draw functions derive from animationTick and eyesOpen
+  switch(type) {
+    case EMOJI_HAPPY:
+    case EMOJI_NEUTRAL: return { 0, 1, true };
+    case EMOJI_ANGRY: return { 500, 2, false };       // tick % 20 < 10
+    case EMOJI_SLEEPY: return { ANIM_TICK_MS, 30, false };
+    case EMOJI_PET_HAPPY: return { 250, 2, true };    // tick % 10 < 5
+    case EMOJI_PET_LOVE: return { 500, 2, false };    // tick % 20 < 10
+    case EMOJI_EATING: return { 300, 2, true };       // tick % 12 < 6
+    case EMOJI_THROW_UP: return { ANIM_TICK_MS, 15, false };
+    case EMOJI_CRYING: return { ANIM_TICK_MS, 20, false };
+    case EMOJI_SLEEPING: return { ANIM_TICK_MS, 40, false };
+    default: return { 0, 1, false }; // Static faces
+  }
+}
+
+unsigned long EmojiDrawer::getTimeToNextChange(EmojiType type, unsigned long timeMs) {
+  return animTimeToChange(getFacePhase(type), timeMs);
+}
+
+// Render into the display buffer without sending it
+void EmojiDrawer::renderEmoji(EmojiType type, unsigned long timeMs) {
+  animationTick = (int)animTick(timeMs);
+  eyesOpen = animEyesOpen(timeMs);
+  
+  uint32_t key = 0;
+  if (spriteCache != nullptr) {
+    key = SpriteCache::makeKey(type, animPhaseIndex(getFacePhase(type), timeMs), faceSize);
+    if (spriteCache->blit(key, display->getBuffer())) {
+      return;
+    }
+  }
+  
   display->clearDisplay();
   
   switch(type) {
@@ -491,6 +501,14 @@ void EmojiDrawer::drawEmoji(EmojiType type, int frame) {
     case EMOJI_NEUTRAL: drawNeutral(); break;
   }
   
+  if (spriteCache != nullptr) {
+    spriteCache->store(key, display->getBuffer());
+  }
+}
+
+// Main drawing function
+void EmojiDrawer::drawEmoji(EmojiType type, unsigned long timeMs) {
+  renderEmoji(type, timeMs);
   display->display();
 }
 
@@ -8,6 +8,9 @@
 
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "sprite_cache.h"
+#include "display_geometry.h"
+#include "anim_clock.h"
 
 // Emoji types enum
 enum EmojiType {
@@ -39,14 +42,19 @@ private:
   int centerX, centerY;  // Center of emoji (typically 64, 32 for 128x64)
   int faceSize;          // Size of the face
   
-  // Animation state
-  unsigned long lastBlink;
+  // Animation state, derived from the time passed to renderEmoji()
   bool eyesOpen;
-  int animationFrame;
+  int animationTick;
+  
+  // Optional cache of rendered frames
+  SpriteCache* spriteCache;
+  
+  // How each face animates over time
+  AnimPhase getFacePhase(EmojiType type);
   
   // Drawing helper functions
   void drawCircle(int x, int y, int radius, bool fill = false);
-  void drawArc(int x, int y, int radiusX, int radiusY, int startAngle, int endAngle);
+  void drawArc(int x, int y, int radiusX, int radiusY, int startAngle, int endAngle, int thickness = 2);
   void drawEye(int x, int y, int size, bool open = true);
   void drawMouth(int x, int y, int width, int type);
   void drawEyebrow(int x, int y, int width, bool angry = false);
@@ -76,15 +84,21 @@ private:
 public:
   EmojiDrawer(Adafruit_SSD1306* disp);
   
-  // Main drawing function
-  void drawEmoji(EmojiType type, int frame = 0);
+  // Main drawing function; timeMs is the animation time (usually millis())
+  void drawEmoji(EmojiType type, unsigned long timeMs);
   
-  // Animation update (for blinking, etc.)
-  void updateAnimation();
+  // Render into the display buffer only (no I2C transfer)
+  void renderEmoji(EmojiType type, unsigned long timeMs);
+  
+  // Milliseconds after timeMs until the face looks different (ANIM_NO_CHANGE if static)
+  unsigned long getTimeToNextChange(EmojiType type, unsigned long timeMs);
   
   // Set emoji position and size
   void setPosition(int x, int y);
   void setSize(int size);
+  
+  // Reuse rendered frames instead of re-drawing every shape
+  void setSpriteCache(SpriteCache* cache) { spriteCache = cache; }
 };
 
 #endif
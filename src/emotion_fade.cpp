@@ -0,0 +1,78 @@
+/*
+ * Mochi Robot - Emotion Fade Implementation
+ */
+
+#include "emotion_fade.h"
+
+// Classic recursive Bayer matrix, thresholds 0..63
+static const uint8_t BAYER8[8][8] = {
+  { 0, 32,  8, 40,  2, 34, 10, 42},
+  {48, 16, 56, 24, 50, 18, 58, 26},
+  {12, 44,  4, 36, 14, 46,  6, 38},
+  {60, 28, 52, 20, 62, 30, 54, 22},
+  { 3, 35, 11, 43,  1, 33,  9, 41},
+  {51, 19, 59, 27, 49, 17, 57, 25},
+  {15, 47,  7, 39, 13, 45,  5, 37},
+  {63, 31, 55, 23, 61, 29, 53, 21}
+};
+
+EmotionFade::EmotionFade(uint8_t fadeFrames) {
+  memset(outgoing, 0, sizeof(outgoing));
+  memset(last, 0, sizeof(last));
+  haveLast = false;
+  active = false;
+  frames = fadeFrames > 0 ? fadeFrames : 1;
+  step = 0;
+  fadesStarted = 0;
+  lastBlendMicros = 0;
+}
+
+void EmotionFade::begin() {
+  if (!haveLast) return;
+  memcpy(outgoing, last, sizeof(outgoing));
+  step = 0;
+  active = true;
+  fadesStarted++;
+}
+
+void EmotionFade::cancel() {
+  active = false;
+  haveLast = false;
+}
+
+void EmotionFade::apply(uint8_t* frame) {
+  if (active) {
+    unsigned long start = micros();
+    step++;
+    blend(frame, outgoing, step * FADE_LEVELS / (frames + 1));
+    lastBlendMicros = micros() - start;
+    if (step >= frames) active = false; // The next frame is the new face alone
+  }
+  memcpy(last, frame, sizeof(last));
+  haveLast = true;
+}
+
+void EmotionFade::ditherMask(uint8_t level, uint32_t mask[2]) {
+  uint8_t bytes[8];
+  for (int col = 0; col < 8; col++) {
+    uint8_t bits = 0;
+    for (int row = 0; row < 8; row++) {
+      if (BAYER8[row][col] < level) bits |= 1 << row;
+    }
+    bytes[col] = bits;
+  }
+  memcpy(mask, bytes, sizeof(bytes)); // Byte order matches the frame in memory
+}
+
+void EmotionFade::blend(uint8_t* frame, const uint8_t* from, uint8_t level) {
+  uint32_t mask[2];
+  ditherMask(level, mask);
+
+  // Both buffers are word-aligned and the pattern restarts every 8 bytes
+  uint32_t* dst = (uint32_t*)frame;
+  const uint32_t* src = (const uint32_t*)from;
+  for (int i = 0; i < Panel::frameBytes / 4; i += 2) {
+    dst[i] = src[i] ^ ((src[i] ^ dst[i]) & mask[0]);
+    dst[i + 1] = src[i + 1] ^ ((src[i + 1] ^ dst[i + 1]) & mask[1]);
+  }
+}
@@ -0,0 +1,66 @@
+/*
+ * Mochi Robot - Emotion Fade
+ * Dithered cross-fade from the old face to the new one on emotion changes
+ *
+ * Every eye frame EyeEngine presents passes through apply() (MochiDisplay
+ * calls it while the fade is attached). begin() freezes the last eye frame
+ * as the outgoing face; the next EMOTION_FADE_FRAMES frames show the
+ * incoming face only where an 8x8 ordered (Bayer) threshold is below the
+ * fade level, so more of it shows up on every frame.
+ *
+ * Page bytes are 8 vertical pixels, so the mask for one column is a byte
+ * and the 8-column pattern is two 32-bit words repeated across the frame:
+ * a blend is one XOR/AND/XOR per word, no per-pixel work.
+ */
+
+#ifndef EMOTION_FADE_H
+#define EMOTION_FADE_H
+
+#include <Arduino.h>
+#include "display_geometry.h"
+
+#define EMOTION_FADE_FRAMES 8 // About a quarter second at the active eye rate
+#define FADE_LEVELS 64        // 8x8 Bayer thresholds
+
+static_assert(Panel::width % 8 == 0, "Dither pattern repeats every 8 columns");
+
+class EmotionFade {
+private:
+  alignas(4) uint8_t outgoing[Panel::frameBytes]; // Frozen old face
+  alignas(4) uint8_t last[Panel::frameBytes];     // Last eye frame shown
+  bool haveLast;
+  bool active;
+  uint8_t frames;
+  uint8_t step;
+
+  // Statistics
+  unsigned long fadesStarted;
+  unsigned long lastBlendMicros;
+
+public:
+  EmotionFade(uint8_t fadeFrames = EMOTION_FADE_FRAMES);
+
+  // Start fading from the last eye frame (no-op until one was seen).
+  // Restarting mid-fade fades from what is on screen.
+  void begin();
+
+  // Stop and forget the last eye frame (the eyes are no longer shown)
+  void cancel();
+
+  // Blend an incoming eye frame in place (4-byte aligned, Panel::frameBytes)
+  void apply(uint8_t* frame);
+
+  bool isActive() { return active; }
+
+  // Mask words for one level 0..FADE_LEVELS: bits set show the incoming frame
+  static void ditherMask(uint8_t level, uint32_t mask[2]);
+
+  // frame = incoming where the level's mask is set, `from` elsewhere
+  static void blend(uint8_t* frame, const uint8_t* from, uint8_t level);
+
+  // Statistics
+  unsigned long getFadesStarted() { return fadesStarted; }
+  unsigned long getLastBlendMicros() { return lastBlendMicros; }
+};
+
+#endif
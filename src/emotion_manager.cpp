@@ -7,8 +7,9 @@
 #include <time.h>
 #include "emotion_manager.h"
 
-EmotionManager::EmotionManager(RoboEyes<Adafruit_SSD1306>* roboEyes) {
-  eyes = roboEyes;
+EmotionManager::EmotionManager(EyeEngine<MochiDisplay>* eyeEngine) {
+  eyes = eyeEngine;
+  fade = nullptr;
   currentEmotion = EMO_NEUTRAL;
   emotionStartTime = 0;
   emotionDuration = 0;
@@ -54,12 +55,15 @@ void EmotionManager::update() {
 }
 
 void EmotionManager::setEmotion(MochiEmotion emotion, unsigned long duration) {
+  if (fade != nullptr && emotion != currentEmotion) {
+    fade->begin(); // Old face dissolves into the new one over the next frames
+  }
   currentEmotion = emotion;
   emotionStartTime = millis();
   emotionDuration = duration;
   emotionActive = (duration > 0);
   
-  applyEmotionToRoboEyes(emotion);
+  applyEmotionToEyes(emotion);
 }
 
 void EmotionManager::setInteracting(bool interacting) {
@@ -134,59 +138,67 @@ void EmotionManager::updateEmotionFromFactors() {
   }
 }
 
-void EmotionManager::applyEmotionToRoboEyes(MochiEmotion emotion) {
+void EmotionManager::applyEmotionToEyes(MochiEmotion emotion) {
+  // Every emotion is a full pose; the engine tweens to it from wherever the eyes are
+  EyePose pose = eyeMoodPose(EYE_MOOD_DEFAULT);
+  eyes->setSweat(emotion == EMO_WORRIED);
+  
   switch(emotion) {
     case EMO_NEUTRAL:
-      eyes->setMood(DEFAULT);
-      eyes->setIdleMode(ON, 3, 2); // Idle mode: look around every 3-5 seconds
-      eyes->setAutoblinker(ON, 3, 2); // Auto blink every 3-5 seconds
+      eyes->setIdleMode(true, 3, 2); // Idle mode: look around every 3-5 seconds
+      eyes->setAutoblinker(true, 3, 2); // Auto blink every 3-5 seconds
       break;
       
     case EMO_HAPPY:
-      eyes->setMood(HAPPY);
-      eyes->setIdleMode(OFF);
-      eyes->setAutoblinker(ON, 2, 1);
+      pose = eyeMoodPose(EYE_MOOD_HAPPY);
+      eyes->setIdleMode(false);
+      eyes->setAutoblinker(true, 2, 1);
       break;
       
     case EMO_SLEEPY:
-      eyes->setMood(TIRED);
-      eyes->setIdleMode(OFF);
-      eyes->setAutoblinker(OFF);
+      pose = eyeMoodPose(EYE_MOOD_TIRED);
+      pose.openness = EYE_Q8 * 5 / 8; // Heavy lids
+      pose.gazeY = EYE_Q8 / 4;
+      eyes->setIdleMode(false);
+      eyes->setAutoblinker(false);
       break;
       
     case EMO_SAD:
-      eyes->setMood(DEFAULT);
-      eyes->setPosition(S); // Look down
-      eyes->setIdleMode(OFF);
-      eyes->setAutoblinker(ON, 4, 2);
+      pose.lidTired = EYE_Q8 / 2;
+      pose.gazeY = EYE_Q8; // Look down
+      pose.squash = -EYE_MAX_SQUASH / 4;
+      eyes->setIdleMode(false);
+      eyes->setAutoblinker(true, 4, 2);
       break;
       
     case EMO_ANGRY:
-      eyes->setMood(ANGRY);
-      eyes->setIdleMode(OFF);
-      eyes->setAutoblinker(OFF);
+      pose = eyeMoodPose(EYE_MOOD_ANGRY);
+      pose.squash = EYE_MAX_SQUASH / 2; // Narrowed
+      eyes->setIdleMode(false);
+      eyes->setAutoblinker(false);
       break;
       
     case EMO_EXCITED:
-      eyes->setMood(HAPPY);
-      eyes->anim_laugh(); // Play laugh animation
-      eyes->setIdleMode(OFF);
-      eyes->setAutoblinker(ON, 1, 1);
+      pose = eyeMoodPose(EYE_MOOD_HAPPY);
+      pose.squash = -EYE_MAX_SQUASH / 2; // Wide open
+      eyes->playLaugh();
+      eyes->setIdleMode(false);
+      eyes->setAutoblinker(true, 1, 1);
       break;
       
     case EMO_IDLE:
-      eyes->setMood(DEFAULT);
-      eyes->setIdleMode(ON, 5, 3); // Look around every 5-8 seconds
-      eyes->setAutoblinker(ON, 4, 2);
+      eyes->setIdleMode(true, 5, 3); // Look around every 5-8 seconds
+      eyes->setAutoblinker(true, 4, 2);
       break;
       
     case EMO_WORRIED:
-      eyes->setMood(DEFAULT);
-      eyes->setSweat(ON); // Show sweat
-      eyes->setIdleMode(OFF);
-      eyes->setAutoblinker(ON, 2, 1);
+      pose.lidTired = EYE_Q8 / 2; // Raised inner brows, plus the sweat drop
+      eyes->setIdleMode(false);
+      eyes->setAutoblinker(true, 2, 1);
       break;
   }
+  
+  eyes->setPose(pose, EYE_MOOD_MS, EASE_IN_OUT);
 }
 
 MochiEmotion EmotionManager::getRandomEmotion() {
@@ -232,22 +244,22 @@ void EmotionManager::triggerRandomEmotion() {
     case EMO_HAPPY:
       // 50% chance to laugh
       if (random(100) < 50) {
-        eyes->anim_laugh();
+        eyes->playLaugh();
       }
       break;
     case EMO_EXCITED:
-      eyes->anim_laugh();
+      eyes->playLaugh();
       break;
     case EMO_SAD:
       // Sometimes confused, sometimes just look down
       if (random(100) < 30) {
-        eyes->anim_confused();
+        eyes->playConfused();
       }
       break;
     case EMO_NEUTRAL:
       // Occasionally do a quick animation
       if (random(100) < 20) {
-        eyes->anim_confused();
+        eyes->playConfused();
       }
       break;
     default:
@@ -1,6 +1,6 @@
 /*
  * Mochi Robot - Emotion Management System
- * Maps emotions to RoboEyes library moods and animations
+ * Maps emotions to EyeEngine poses and animations
  */
 
 #ifndef EMOTION_MANAGER_H
@@ -8,9 +8,11 @@
 
 #include <Arduino.h>
 #include <Adafruit_SSD1306.h>
-#include "../RoboEyes/src/FluxGarage_RoboEyes.h"
+#include "mochi_display.h"
+#include "eye_engine.h"
+#include "emotion_fade.h"
 
-// Emotion types (mapped to RoboEyes)
+// Emotion types (each one is an eye pose)
 enum MochiEmotion {
   EMO_NEUTRAL = 0,
   EMO_HAPPY,
@@ -24,7 +26,8 @@ enum MochiEmotion {
 
 class EmotionManager {
 private:
-  RoboEyes<Adafruit_SSD1306>* eyes;
+  EyeEngine<MochiDisplay>* eyes;
+  EmotionFade* fade; // Cross-fades the face on every change (nullptr for a cut)
   MochiEmotion currentEmotion;
   unsigned long emotionStartTime;
   unsigned long emotionDuration;
@@ -42,12 +45,13 @@ private:
   bool randomEmotionsEnabled;
   
 public:
-  EmotionManager(RoboEyes<Adafruit_SSD1306>* roboEyes);
+  EmotionManager(EyeEngine<MochiDisplay>* eyeEngine);
   
   // Main functions
   void update();
   void setEmotion(MochiEmotion emotion, unsigned long duration = 0);
   MochiEmotion getCurrentEmotion() { return currentEmotion; }
+  void setFade(EmotionFade* emotionFade) { fade = emotionFade; }
   
   // Emotion factors
   void setOnline(bool online) { isOnline = online; updateEmotionFromFactors(); }
@@ -70,7 +74,7 @@ public:
   
 private:
   void updateEmotionFromFactors();
-  void applyEmotionToRoboEyes(MochiEmotion emotion);
+  void applyEmotionToEyes(MochiEmotion emotion);
 };
 
 #endif
@@ -0,0 +1,331 @@
+/*
+ * Mochi Robot - Eye Engine Implementation
+ */
+
+#include "eye_engine.h"
+
+// Tracks are deltas on the base pose and end on a zero pose
+const EyeKeyframe EYE_TRACK_BLINK[] = {
+  {{-EYE_Q8, 0, 0, 0, 0, 0, 0}, 70, EASE_IN},
+  {{0, 0, 0, 0, 0, 0, 0}, 110, EASE_OUT}
+};
+const uint8_t EYE_TRACK_BLINK_LENGTH = sizeof(EYE_TRACK_BLINK) / sizeof(EYE_TRACK_BLINK[0]);
+
+// Three hops, squashing a little on every landing
+const EyeKeyframe EYE_TRACK_LAUGH[] = {
+  {{0, 0, -90, 0, 0, 0, 0}, 70, EASE_OUT},
+  {{0, 0, 0, 24, 0, 0, 0}, 70, EASE_IN},
+  {{0, 0, -90, 0, 0, 0, 0}, 70, EASE_OUT},
+  {{0, 0, 0, 24, 0, 0, 0}, 70, EASE_IN},
+  {{0, 0, -90, 0, 0, 0, 0}, 70, EASE_OUT},
+  {{0, 0, 0, 24, 0, 0, 0}, 70, EASE_IN},
+  {{0, 0, 0, 0, 0, 0, 0}, 80, EASE_OUT}
+};
+const uint8_t EYE_TRACK_LAUGH_LENGTH = sizeof(EYE_TRACK_LAUGH) / sizeof(EYE_TRACK_LAUGH[0]);
+
+// Side to side shake
+const EyeKeyframe EYE_TRACK_CONFUSED[] = {
+  {{0, 56, 0, 0, 0, 0, 0}, 80, EASE_IN_OUT},
+  {{0, -56, 0, 0, 0, 0, 0}, 80, EASE_IN_OUT},
+  {{0, 56, 0, 0, 0, 0, 0}, 80, EASE_IN_OUT},
+  {{0, -56, 0, 0, 0, 0, 0}, 80, EASE_IN_OUT},
+  {{0, 0, 0, 0, 0, 0, 0}, 80, EASE_IN_OUT}
+};
+const uint8_t EYE_TRACK_CONFUSED_LENGTH = sizeof(EYE_TRACK_CONFUSED) / sizeof(EYE_TRACK_CONFUSED[0]);
+
+int32_t eyeEase(EyeEasing easing, int32_t t) {
+  if (t <= 0) return 0;
+  if (t >= EYE_EASE_ONE) return EYE_EASE_ONE;
+
+  switch (easing) {
+    case EASE_IN:
+      return (t * t) >> 15;
+    case EASE_OUT: {
+      int32_t u = EYE_EASE_ONE - t;
+      return EYE_EASE_ONE - ((u * u) >> 15);
+    }
+    case EASE_IN_OUT: {
+      // t^2 (3 - 2t); the product peaks near 3.2e9, so stay unsigned
+      uint32_t t2 = ((uint32_t)t * (uint32_t)t) >> 15;
+      return (int32_t)((t2 * (uint32_t)(3 * EYE_EASE_ONE - 2 * t)) >> 15);
+    }
+    default:
+      return t;
+  }
+}
+
+static inline int16_t lerpField(int16_t a, int16_t b, int32_t t) {
+  return a + (int16_t)(((int32_t)b - a) * t / EYE_EASE_ONE);
+}
+
+EyePose eyeLerp(const EyePose& a, const EyePose& b, int32_t t) {
+  EyePose pose;
+  pose.openness = lerpField(a.openness, b.openness, t);
+  pose.gazeX = lerpField(a.gazeX, b.gazeX, t);
+  pose.gazeY = lerpField(a.gazeY, b.gazeY, t);
+  pose.squash = lerpField(a.squash, b.squash, t);
+  pose.lidTired = lerpField(a.lidTired, b.lidTired, t);
+  pose.lidAngry = lerpField(a.lidAngry, b.lidAngry, t);
+  pose.lidHappy = lerpField(a.lidHappy, b.lidHappy, t);
+  return pose;
+}
+
+EyePose eyeMoodPose(EyeMood mood) {
+  EyePose pose = {EYE_Q8, 0, 0, 0, 0, 0, 0};
+  switch (mood) {
+    case EYE_MOOD_TIRED: pose.lidTired = EYE_Q8; break;
+    case EYE_MOOD_ANGRY: pose.lidAngry = EYE_Q8; break;
+    case EYE_MOOD_HAPPY: pose.lidHappy = EYE_Q8; break;
+    default: break;
+  }
+  return pose;
+}
+
+// ---- EyeTrack ----
+
+EyeTrack::EyeTrack() {
+  frames = nullptr;
+  count = 0;
+  startTime = 0;
+}
+
+void EyeTrack::play(const EyeKeyframe* keyframes, uint8_t length, unsigned long now) {
+  frames = keyframes;
+  count = length;
+  startTime = now;
+}
+
+void EyeTrack::evaluate(unsigned long now, EyePose& delta) {
+  memset(&delta, 0, sizeof(delta));
+  if (frames == nullptr) return;
+
+  unsigned long elapsed = now - startTime;
+  EyePose previous = delta;
+  for (int i = 0; i < count; i++) {
+    const EyeKeyframe& key = frames[i];
+    if (elapsed < key.durationMs) {
+      int32_t t = (int32_t)(elapsed * EYE_EASE_ONE / key.durationMs);
+      delta = eyeLerp(previous, key.pose, eyeEase(key.easing, t));
+      return;
+    }
+    elapsed -= key.durationMs;
+    previous = key.pose;
+  }
+  frames = nullptr; // Done; the last keyframe is the zero pose
+}
+
+// ---- EyeAnimator ----
+
+static unsigned long scheduleAfter(unsigned long now, uint16_t interval, uint16_t variation) {
+  return now + interval * 1000UL + (variation > 0 ? random(variation * 1000L) : 0);
+}
+
+static inline int16_t clampField(int32_t value, int32_t low, int32_t high) {
+  return (int16_t)(value < low ? low : (value > high ? high : value));
+}
+
+EyeAnimator::EyeAnimator() {
+  from = eyeMoodPose(EYE_MOOD_DEFAULT);
+  to = from;
+  tweenStart = 0;
+  tweenMs = 0;
+  tweenEasing = EASE_LINEAR;
+  autoblink = false;
+  blinkInterval = 3;
+  blinkVariation = 2;
+  nextBlink = 0;
+  idleMode = false;
+  idleInterval = 3;
+  idleVariation = 2;
+  nextIdle = 0;
+  sweat = false;
+}
+
+EyePose EyeAnimator::basePose(unsigned long now) {
+  unsigned long elapsed = now - tweenStart;
+  if (tweenMs == 0 || elapsed >= tweenMs) return to;
+  return eyeLerp(from, to, eyeEase(tweenEasing, (int32_t)(elapsed * EYE_EASE_ONE / tweenMs)));
+}
+
+void EyeAnimator::setPose(const EyePose& pose, uint16_t durationMs, EyeEasing easing, unsigned long now) {
+  from = basePose(now); // Retargeting mid-tween carries on from where the eyes are
+  to = pose;
+  tweenStart = now;
+  tweenMs = durationMs;
+  tweenEasing = easing;
+}
+
+void EyeAnimator::setPose(const EyePose& pose, uint16_t durationMs, EyeEasing easing) {
+  setPose(pose, durationMs, easing, millis());
+}
+
+void EyeAnimator::setMood(EyeMood mood) {
+  EyePose mooded = eyeMoodPose(mood);
+  EyePose pose = to;
+  pose.lidTired = mooded.lidTired;
+  pose.lidAngry = mooded.lidAngry;
+  pose.lidHappy = mooded.lidHappy;
+  setPose(pose, EYE_MOOD_MS, EASE_IN_OUT);
+}
+
+void EyeAnimator::lookAt(int16_t gazeX, int16_t gazeY, uint16_t durationMs) {
+  EyePose pose = to;
+  pose.gazeX = clampField(gazeX, -EYE_Q8, EYE_Q8);
+  pose.gazeY = clampField(gazeY, -EYE_Q8, EYE_Q8);
+  setPose(pose, durationMs, EASE_IN_OUT);
+}
+
+void EyeAnimator::setAutoblinker(bool enabled, uint16_t interval, uint16_t variation) {
+  autoblink = enabled;
+  blinkInterval = interval;
+  blinkVariation = variation;
+  nextBlink = scheduleAfter(millis(), interval, variation);
+}
+
+void EyeAnimator::setIdleMode(bool enabled, uint16_t interval, uint16_t variation) {
+  idleMode = enabled;
+  idleInterval = interval;
+  idleVariation = variation;
+  nextIdle = scheduleAfter(millis(), interval, variation);
+}
+
+void EyeAnimator::tick(unsigned long now) {
+  if (autoblink && (long)(now - nextBlink) >= 0) {
+    blinkTrack.play(EYE_TRACK_BLINK, EYE_TRACK_BLINK_LENGTH, now);
+    nextBlink = scheduleAfter(now, blinkInterval, blinkVariation);
+  }
+  if (idleMode && (long)(now - nextIdle) >= 0) {
+    EyePose pose = to;
+    pose.gazeX = random(-EYE_Q8, EYE_Q8 + 1);
+    pose.gazeY = random(-EYE_Q8, EYE_Q8 + 1);
+    setPose(pose, EYE_GAZE_MS, EASE_IN_OUT, now);
+    nextIdle = scheduleAfter(now, idleInterval, idleVariation);
+  }
+}
+
+EyePose EyeAnimator::evaluate(unsigned long now) {
+  EyePose pose = basePose(now);
+  EyePose blinkDelta, animDelta;
+  blinkTrack.evaluate(now, blinkDelta);
+  animTrack.evaluate(now, animDelta);
+
+  pose.openness = clampField(pose.openness + blinkDelta.openness + animDelta.openness, 0, EYE_Q8);
+  pose.gazeX = clampField(pose.gazeX + blinkDelta.gazeX + animDelta.gazeX, -EYE_Q8, EYE_Q8);
+  pose.gazeY = clampField(pose.gazeY + blinkDelta.gazeY + animDelta.gazeY, -EYE_Q8, EYE_Q8);
+  pose.squash = clampField(pose.squash + blinkDelta.squash + animDelta.squash, -EYE_MAX_SQUASH, EYE_MAX_SQUASH);
+  pose.lidTired = clampField(pose.lidTired + blinkDelta.lidTired + animDelta.lidTired, 0, EYE_Q8);
+  pose.lidAngry = clampField(pose.lidAngry + blinkDelta.lidAngry + animDelta.lidAngry, 0, EYE_Q8);
+  pose.lidHappy = clampField(pose.lidHappy + blinkDelta.lidHappy + animDelta.lidHappy, 0, EYE_Q8);
+  return pose;
+}
+
+EyeFrame EyeAnimator::layoutFrame(const EyePose& pose, unsigned long now) {
+  EyeFrame frame;
+  memset(&frame, 0, sizeof(frame)); // Compared with memcmp
+
+  // Travel that keeps unsquashed eyes on the panel
+  const int maxX = (Panel::width - 2 * EYE_WIDTH - EYE_GAP) / 2;
+  const int maxY = (Panel::height - EYE_HEIGHT) / 2;
+
+  int w = EYE_WIDTH * (EYE_Q8 + pose.squash) / EYE_Q8;
+  int fullHeight = EYE_HEIGHT * (EYE_Q8 - pose.squash) / EYE_Q8;
+  int h = fullHeight * pose.openness / EYE_Q8;
+  if (h < 1) h = 1; // Shut eyes are a line
+  int half = h / 2;
+  int dx = pose.gazeX * maxX / EYE_Q8;
+  int dy = pose.gazeY * maxY / EYE_Q8;
+  int radius = min(EYE_RADIUS, min(w, h) / 2);
+
+  int sweatY = -1;
+  if (sweat) {
+    sweatY = (now % EYE_SWEAT_PERIOD_MS) * (fullHeight / 2) / EYE_SWEAT_PERIOD_MS;
+  }
+
+  for (int i = 0; i < 2; i++) {
+    EyeShape& eye = frame.eyes[i];
+    // Mirror images around the panel centre when the gaze is centred
+    eye.x = (i == 0 ? Panel::centerX - EYE_GAP / 2 - w : Panel::width - Panel::centerX + EYE_GAP / 2) + dx;
+    eye.y = Panel::centerY + dy - half;
+    eye.w = w;
+    eye.h = h;
+    eye.radius = radius;
+    eye.tired = pose.lidTired * half / EYE_Q8;
+    eye.angry = pose.lidAngry * half / EYE_Q8;
+    eye.happy = pose.lidHappy * half / EYE_Q8;
+    eye.sweatY = sweatY;
+    eye.mirrored = i;
+  }
+  return frame;
+}
+
+// ---- Drawing ----
+
+void eyeDrawShape(Adafruit_SSD1306* display, const EyeShape& shape) {
+  int w = shape.w;
+  int r = shape.radius;
+  int span = (w > 1) ? w - 1 : 1;
+
+  // Rows the rounded corners take off each end, per column from the side
+  int8_t insets[EYE_RADIUS + 1];
+  for (int edge = 0; edge < r; edge++) {
+    int d = r - edge;
+    int rest = r * r - d * d;
+    int root = 0;
+    while ((root + 1) * (root + 1) <= rest) root++;
+    insets[edge] = r - root;
+  }
+
+  for (int c = 0; c < w; c++) {
+    int edge = min(c, w - 1 - c);
+    int inset = (edge < r) ? insets[edge] : 0;
+
+    // Tired lids slope down to the outer corner, angry ones to the inner
+    int outer = shape.mirrored ? (w - 1 - c) : c;
+    int lid = (shape.tired * (span - outer) + shape.angry * outer) / span;
+
+    // Happy: the bottom arches up, twice as far in the middle as at the sides
+    int d = 2 * c - (w - 1);
+    int arch = shape.happy - shape.happy * d * d / (2 * span * span);
+
+    int top = shape.y + max(inset, lid);
+    int bottom = shape.y + shape.h - 1 - max(inset, arch);
+    if (top <= bottom) {
+      fbDrawVLine(display, shape.x + c, top, bottom - top + 1, SSD1306_WHITE);
+    }
+  }
+
+  if (shape.sweatY >= 0) {
+    int dropX = shape.mirrored ? shape.x + w + 3 : shape.x - 4;
+    fbFillCircle(display, dropX, shape.y + shape.sweatY + 2, 2, SSD1306_WHITE);
+  }
+}
+
+EyeRect eyeBounds(const EyeShape& shape) {
+  int x0 = shape.x;
+  int x1 = shape.x + shape.w;
+  int y0 = shape.y;
+  int y1 = shape.y + shape.h;
+  if (shape.sweatY >= 0) {
+    if (shape.mirrored) x1 += EYE_SWEAT_MARGIN; else x0 -= EYE_SWEAT_MARGIN;
+    y1 = max(y1, shape.y + shape.sweatY + 5);
+  }
+
+  // Clip to the panel
+  x0 = max(x0, 0);
+  y0 = max(y0, 0);
+  x1 = min(x1, (int)Panel::width);
+  y1 = min(y1, (int)Panel::height);
+  EyeRect rect = {(int16_t)x0, (int16_t)y0, (int16_t)max(x1 - x0, 0), (int16_t)max(y1 - y0, 0)};
+  return rect;
+}
+
+EyeRect eyeUnion(const EyeRect& a, const EyeRect& b) {
+  if (a.w <= 0 || a.h <= 0) return b;
+  if (b.w <= 0 || b.h <= 0) return a;
+  int x0 = min(a.x, b.x);
+  int y0 = min(a.y, b.y);
+  int x1 = max(a.x + a.w, b.x + b.w);
+  int y1 = max(a.y + a.h, b.y + b.h);
+  EyeRect rect = {(int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+  return rect;
+}
@@ -0,0 +1,298 @@
+/*
+ * Mochi Robot - Eye Engine
+ * In-tree robot eyes: keyframed poses, fixed-point easing, dirty-rect drawing
+ *
+ * An EyePose is everything the eyes can do: openness, gaze (the eye shapes
+ * shift like pupils), squash and the three mood lids, all Q8 (256 = full).
+ * EyeAnimator tweens a base pose towards setPose() targets and layers two
+ * keyframe tracks on top of it, one for blinks and one for bounces such as
+ * playLaugh(). Easing is Q15 integer math: no floats, no trig.
+ *
+ * EyeEngine<DisplayT> draws the pose as two rounded eyes, one vertical span
+ * per column. A frame only clears and redraws the eye bounding boxes (this
+ * frame's and the last one's), so the rest of the buffer is left alone and
+ * the cost per frame is bounded by the box area whatever the pose. It is a
+ * template so display() resolves to the display's own version; DisplayT is
+ * an Adafruit_SSD1306 or, like MochiDisplay, has canvas() and clearDisplay().
+ */
+
+#ifndef EYE_ENGINE_H
+#define EYE_ENGINE_H
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include "display_geometry.h"
+#include "fb_primitives.h"
+
+#define EYE_Q8 256
+#define EYE_EASE_ONE 32768 // Q15 progress
+
+// Eye size and spacing (the old RoboEyes look on 128x64)
+#define EYE_WIDTH   Panel::layout(36, 30)
+#define EYE_HEIGHT  Panel::layout(36, 20)
+#define EYE_RADIUS  Panel::layout(8, 6)
+#define EYE_GAP     Panel::layout(10, 12)
+#define EYE_MAX_SQUASH 64      // Q8: eyes at most 25% wider and flatter
+#define EYE_SWEAT_MARGIN 6     // Room beside each eye for its sweat drop
+#define EYE_SWEAT_PERIOD_MS 1200
+
+// Tween times
+#define EYE_MOOD_MS 300
+#define EYE_GAZE_MS 250
+#define EYE_LID_MS  400 // open() / close()
+
+enum EyeMood : uint8_t {
+  EYE_MOOD_DEFAULT = 0,
+  EYE_MOOD_TIRED,  // Outer top corners covered
+  EYE_MOOD_ANGRY,  // Inner top corners covered
+  EYE_MOOD_HAPPY   // Bottom pushed up into an arch
+};
+
+enum EyeEasing : uint8_t {
+  EASE_LINEAR = 0,
+  EASE_IN,      // t^2
+  EASE_OUT,     // 1 - (1 - t)^2
+  EASE_IN_OUT   // Smoothstep
+};
+
+struct EyePose {
+  int16_t openness; // 0 = shut, 256 = open
+  int16_t gazeX;    // -256..256 of the horizontal travel (right is positive)
+  int16_t gazeY;    // -256..256 of the vertical travel (down is positive)
+  int16_t squash;   // -EYE_MAX_SQUASH..EYE_MAX_SQUASH, positive = wider and flatter
+  int16_t lidTired; // Mood lids, 0..256 of half the eye height
+  int16_t lidAngry;
+  int16_t lidHappy;
+};
+
+// One step of a track: reach `pose` (a delta on the base pose) in durationMs
+struct EyeKeyframe {
+  EyePose pose;
+  uint16_t durationMs;
+  EyeEasing easing;
+};
+
+// Q15 progress through an easing curve
+int32_t eyeEase(EyeEasing easing, int32_t t);
+
+// a + (b - a) * t, t in Q15
+EyePose eyeLerp(const EyePose& a, const EyePose& b, int32_t t);
+
+// Open eyes looking ahead with the mood's lids
+EyePose eyeMoodPose(EyeMood mood);
+
+// Built-in tracks
+extern const EyeKeyframe EYE_TRACK_BLINK[];
+extern const uint8_t EYE_TRACK_BLINK_LENGTH;
+extern const EyeKeyframe EYE_TRACK_LAUGH[];
+extern const uint8_t EYE_TRACK_LAUGH_LENGTH;
+extern const EyeKeyframe EYE_TRACK_CONFUSED[];
+extern const uint8_t EYE_TRACK_CONFUSED_LENGTH;
+
+// Plays keyframes in order, starting from a zero delta
+class EyeTrack {
+private:
+  const EyeKeyframe* frames;
+  uint8_t count;
+  unsigned long startTime;
+
+public:
+  EyeTrack();
+
+  void play(const EyeKeyframe* keyframes, uint8_t length, unsigned long now);
+  void stop() { frames = nullptr; }
+  bool isPlaying() { return frames != nullptr; }
+
+  // Delta at `now`, added to the base pose; zero (and stopped) once done
+  void evaluate(unsigned long now, EyePose& delta);
+};
+
+// One eye as drawn: rounded rect plus lid cuts, in pixels
+struct EyeShape {
+  int16_t x, y, w, h;
+  int16_t radius;
+  int16_t tired, angry, happy; // Lid depth in rows
+  int16_t sweatY;              // Drop offset below the eye top, -1 = none
+  int16_t mirrored;            // Right eye: outer side is on the right
+};
+
+struct EyeFrame {
+  EyeShape eyes[2];
+};
+
+struct EyeRect {
+  int16_t x, y, w, h;
+};
+
+// Everything but the drawing: timing, tweens, tracks, idle/blink schedule
+class EyeAnimator {
+private:
+  EyePose from;  // Base tween
+  EyePose to;
+  unsigned long tweenStart;
+  uint16_t tweenMs;
+  EyeEasing tweenEasing;
+
+  EyeTrack blinkTrack;
+  EyeTrack animTrack;
+
+  bool autoblink;
+  uint16_t blinkInterval;  // Seconds
+  uint16_t blinkVariation;
+  unsigned long nextBlink;
+
+  bool idleMode;
+  uint16_t idleInterval;
+  uint16_t idleVariation;
+  unsigned long nextIdle;
+
+  bool sweat;
+
+  EyePose basePose(unsigned long now);
+
+public:
+  EyeAnimator();
+
+  // Tween the base pose to `pose` from wherever it is now
+  void setPose(const EyePose& pose, uint16_t durationMs = EYE_MOOD_MS, EyeEasing easing = EASE_IN_OUT);
+  // Same, starting at `now` on the drawFrame() timeline (tests, benchmarks)
+  void setPose(const EyePose& pose, uint16_t durationMs, EyeEasing easing, unsigned long now);
+  EyePose getTargetPose() { return to; }
+
+  // Mood lids only; gaze and openness are kept
+  void setMood(EyeMood mood);
+
+  // Gaze only (-256..256 each)
+  void lookAt(int16_t gazeX, int16_t gazeY, uint16_t durationMs = EYE_GAZE_MS);
+
+  void open() { EyePose pose = to; pose.openness = EYE_Q8; setPose(pose, EYE_LID_MS, EASE_OUT); }
+  void close() { EyePose pose = to; pose.openness = 0; setPose(pose, EYE_LID_MS, EASE_IN); }
+
+  // Random blinks / glances every interval + random(variation) seconds
+  void setAutoblinker(bool enabled, uint16_t interval = 3, uint16_t variation = 2);
+  void setIdleMode(bool enabled, uint16_t interval = 3, uint16_t variation = 2);
+  void setSweat(bool enabled) { sweat = enabled; }
+
+  // One-shot tracks
+  void blink() { blinkTrack.play(EYE_TRACK_BLINK, EYE_TRACK_BLINK_LENGTH, millis()); }
+  void playLaugh() { animTrack.play(EYE_TRACK_LAUGH, EYE_TRACK_LAUGH_LENGTH, millis()); }
+  void playConfused() { animTrack.play(EYE_TRACK_CONFUSED, EYE_TRACK_CONFUSED_LENGTH, millis()); }
+  void playTrack(const EyeKeyframe* keyframes, uint8_t length) { playTrack(keyframes, length, millis()); }
+  void playTrack(const EyeKeyframe* keyframes, uint8_t length, unsigned long now) { animTrack.play(keyframes, length, now); }
+
+  // Pose at `now`: base tween plus both tracks, clamped
+  EyePose evaluate(unsigned long now);
+
+  // Schedule blinks and glances that are due
+  void tick(unsigned long now);
+
+  // Pixel geometry of a pose
+  EyeFrame layoutFrame(const EyePose& pose, unsigned long now);
+};
+
+// Rasterize one eye with vertical spans
+void eyeDrawShape(Adafruit_SSD1306* display, const EyeShape& shape);
+
+// Box the shape (and its sweat drop) touches
+EyeRect eyeBounds(const EyeShape& shape);
+
+// Smallest rect holding both
+EyeRect eyeUnion(const EyeRect& a, const EyeRect& b);
+
+// The surface EyeEngine draws into: the display itself, or its canvas()
+inline Adafruit_SSD1306* eyeCanvas(Adafruit_SSD1306* display) { return display; }
+template<typename DisplayT>
+auto eyeCanvas(DisplayT* display) -> decltype(display->canvas()) { return display->canvas(); }
+
+template<typename DisplayT>
+class EyeEngine : public EyeAnimator {
+private:
+  DisplayT* display;
+  unsigned long frameInterval;
+  unsigned long lastFrameTime;
+  EyeFrame lastFrame;
+  EyeRect lastBox[2];
+  EyeRect dirty;
+  bool fullRedraw; // Buffer holds something else: clear it all once
+
+  // Statistics
+  unsigned long framesDrawn;
+  unsigned long framesSkipped; // Pose unchanged, nothing redrawn
+
+public:
+  EyeEngine(DisplayT& disp) {
+    display = &disp;
+    frameInterval = 20;
+    lastFrameTime = 0;
+    memset(&lastFrame, 0, sizeof(lastFrame));
+    memset(lastBox, 0, sizeof(lastBox));
+    dirty = {0, 0, 0, 0};
+    fullRedraw = true;
+    framesDrawn = 0;
+    framesSkipped = 0;
+  }
+
+  void begin(uint8_t fps) {
+    setFramerate(fps);
+    fullRedraw = true;
+  }
+
+  void setFramerate(uint8_t fps) { frameInterval = 1000 / (fps > 0 ? fps : 1); }
+
+  // Something else drew into the buffer: the next frame clears it all
+  void invalidate() { fullRedraw = true; }
+
+  // Draw and present a frame when one is due
+  void update() {
+    unsigned long now = millis();
+    if (now - lastFrameTime < frameInterval) return;
+    lastFrameTime = now;
+    drawFrame(now);
+    display->display();
+  }
+
+  // Render the pose at `now` into the buffer (no display() call)
+  void drawFrame(unsigned long now) {
+    tick(now);
+    EyeFrame frame = layoutFrame(evaluate(now), now);
+
+    if (fullRedraw) {
+      display->clearDisplay();
+    } else if (memcmp(&frame, &lastFrame, sizeof(frame)) == 0) {
+      dirty = {0, 0, 0, 0};
+      framesSkipped++;
+      return;
+    }
+
+    EyeRect box[2];
+    for (int i = 0; i < 2; i++) {
+      box[i] = eyeBounds(frame.eyes[i]);
+    }
+    if (fullRedraw) {
+      dirty = {0, 0, (int16_t)Panel::width, (int16_t)Panel::height};
+    } else {
+      // Clear where each eye was and where it goes, then draw both
+      EyeRect left = eyeUnion(box[0], lastBox[0]);
+      EyeRect right = eyeUnion(box[1], lastBox[1]);
+      fbFillRect(eyeCanvas(display), left.x, left.y, left.w, left.h, SSD1306_BLACK);
+      fbFillRect(eyeCanvas(display), right.x, right.y, right.w, right.h, SSD1306_BLACK);
+      dirty = eyeUnion(left, right);
+    }
+    for (int i = 0; i < 2; i++) {
+      eyeDrawShape(eyeCanvas(display), frame.eyes[i]);
+      lastBox[i] = box[i];
+    }
+    lastFrame = frame;
+    fullRedraw = false;
+    framesDrawn++;
+  }
+
+  // Area the last drawFrame() touched (w == 0 when the pose was unchanged)
+  EyeRect getDirtyRect() { return dirty; }
+
+  // Statistics
+  unsigned long getFramesDrawn() { return framesDrawn; }
+  unsigned long getFramesSkipped() { return framesSkipped; }
+};
+
+#endif
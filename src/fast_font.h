@@ -0,0 +1,76 @@
+/*
+ * Mochi Robot - Fast Font
+ * Page-aligned text blitter for the classic 5x7 font
+ *
+ * Glyphs are stored column-major with bit0 at the top, the same layout
+ * as SSD1306 page bytes. Scaled glyphs (size 2 and 3) are expanded once
+ * into a small glyph cache; text at a page-aligned y is then ORed into
+ * the buffer a whole byte at a time.
+ */
+
+#ifndef FAST_FONT_H
+#define FAST_FONT_H
+
+#include <Adafruit_SSD1306.h>
+#include "display_geometry.h"
+
+#define FONT_FIRST_CHAR 32
+#define FONT_LAST_CHAR 126
+#define FONT_GLYPH_WIDTH 5
+#define FONT_CELL_WIDTH 6  // Glyph plus one column of spacing
+#define FONT_CELL_HEIGHT 8
+#define FONT_MAX_SCALE 3
+#define FONT_CACHE_SLOTS 32
+
+// Same cell metrics as Adafruit GFX's built-in font at setTextSize(scale)
+constexpr int fontTextWidth(int length, int scale) {
+  return length * FONT_CELL_WIDTH * scale;
+}
+
+constexpr int fontTextHeight(int scale) {
+  return FONT_CELL_HEIGHT * scale;
+}
+
+// Left edge that centers `length` characters inside `areaWidth`
+constexpr int fontCenterX(int length, int scale, int areaWidth = Panel::width) {
+  return fontTextWidth(length, scale) >= areaWidth ? 0 : (areaWidth - fontTextWidth(length, scale)) / 2;
+}
+
+class FastFont {
+private:
+  struct CachedGlyph {
+    char c;
+    uint8_t scale;
+    uint8_t data[FONT_GLYPH_WIDTH * FONT_MAX_SCALE * FONT_MAX_SCALE]; // Page-major
+  };
+
+  Adafruit_SSD1306* display;
+  CachedGlyph cache[FONT_CACHE_SLOTS];
+
+  // Statistics
+  unsigned long hits;
+  unsigned long misses;
+
+  const uint8_t* getGlyph(char c, uint8_t scale);
+  void blitGlyph(const uint8_t* glyph, int width, int pages, int x, int y);
+
+public:
+  FastFont(Adafruit_SSD1306* disp);
+
+  // Retarget drawing at another buffer (glyph cache is kept)
+  void setDisplay(Adafruit_SSD1306* disp) { display = disp; }
+
+  // Draw one character / a string with its top-left corner at (x, y).
+  // scale is clamped to 1..FONT_MAX_SCALE. Returns the x after the text.
+  int drawChar(int x, int y, char c, uint8_t scale = 1);
+  int drawText(int x, int y, const char* text, uint8_t scale = 1);
+
+  // Draw text horizontally centered on the panel
+  void drawCentered(int y, const char* text, uint8_t scale = 1);
+
+  // Statistics
+  unsigned long getHits() { return hits; }
+  unsigned long getMisses() { return misses; }
+};
+
+#endif
@@ -0,0 +1,237 @@
+/*
+ * Mochi Robot - Framebuffer Primitives Implementation
+ */
+
+#include "fb_primitives.h"
+#include <Arduino.h>
+
+static inline void applyByte(uint8_t* p, uint8_t mask, uint16_t color) {
+  switch (color) {
+    case SSD1306_WHITE:   *p |= mask; break;
+    case SSD1306_BLACK:   *p &= ~mask; break;
+    case SSD1306_INVERSE: *p ^= mask; break;
+  }
+}
+
+// Apply one page mask to `count` neighbouring columns, a word at a time once aligned
+static void applySpan(uint8_t* p, int count, uint8_t mask, uint16_t color) {
+  if (mask == 0xFF && color != SSD1306_INVERSE) {
+    memset(p, color == SSD1306_WHITE ? 0xFF : 0x00, count);
+    return;
+  }
+
+  while (count > 0 && ((uintptr_t)p & 3) != 0) {
+    applyByte(p++, mask, color);
+    count--;
+  }
+
+  uint32_t wide = mask * 0x01010101UL;
+  uint32_t* word = (uint32_t*)p;
+  int words = count >> 2;
+  switch (color) {
+    case SSD1306_WHITE:   for (int i = 0; i < words; i++) word[i] |= wide; break;
+    case SSD1306_BLACK:   for (int i = 0; i < words; i++) word[i] &= ~wide; break;
+    case SSD1306_INVERSE: for (int i = 0; i < words; i++) word[i] ^= wide; break;
+  }
+
+  p += words << 2;
+  for (int i = 0; i < (count & 3); i++) {
+    applyByte(p++, mask, color);
+  }
+}
+
+// Bits first..last (inclusive, 0..7) of a page byte
+static inline uint8_t pageMask(int first, int last) {
+  return (uint8_t)((0xFF << first) & (0xFF >> (7 - last)));
+}
+
+void fbFillRect(Adafruit_SSD1306* display, int x, int y, int w, int h, uint16_t color) {
+  uint8_t* buffer = display->getBuffer();
+  if (buffer == nullptr) return;
+  int panelWidth = display->width();
+  int panelHeight = display->height();
+
+  // Clip
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > panelWidth) w = panelWidth - x;
+  if (y + h > panelHeight) h = panelHeight - y;
+  if (w <= 0 || h <= 0) return;
+
+  int bottom = y + h - 1;
+  for (int page = y >> 3; page <= (bottom >> 3); page++) {
+    int first = (page == (y >> 3)) ? (y & 7) : 0;
+    int last = (page == (bottom >> 3)) ? (bottom & 7) : 7;
+    applySpan(buffer + page * panelWidth + x, w, pageMask(first, last), color);
+  }
+}
+
+void fbDrawHLine(Adafruit_SSD1306* display, int x, int y, int w, uint16_t color) {
+  fbFillRect(display, x, y, w, 1, color);
+}
+
+void fbDrawVLine(Adafruit_SSD1306* display, int x, int y, int h, uint16_t color) {
+  uint8_t* buffer = display->getBuffer();
+  if (buffer == nullptr) return;
+  int panelWidth = display->width();
+  int panelHeight = display->height();
+
+  if (x < 0 || x >= panelWidth) return;
+  if (y < 0) { h += y; y = 0; }
+  if (y + h > panelHeight) h = panelHeight - y;
+  if (h <= 0) return;
+
+  // One masked byte per page instead of one pixel per row
+  int bottom = y + h - 1;
+  uint8_t* column = buffer + x;
+  for (int page = y >> 3; page <= (bottom >> 3); page++) {
+    int first = (page == (y >> 3)) ? (y & 7) : 0;
+    int last = (page == (bottom >> 3)) ? (bottom & 7) : 7;
+    applyByte(column + page * panelWidth, pageMask(first, last), color);
+  }
+}
+
+void fbFillCircle(Adafruit_SSD1306* display, int x0, int y0, int r, uint16_t color) {
+  if (r < 0) return;
+  if (r > FB_MAX_CIRCLE_RADIUS) {
+    display->fillCircle(x0, y0, r, color);
+    return;
+  }
+
+  // Half height of the column at each x offset, walked with the same
+  // midpoint steps as Adafruit_GFX::fillCircleHelper
+  uint8_t half[FB_MAX_CIRCLE_RADIUS + 1];
+  memset(half, 0, r + 1);
+  half[0] = r;
+
+  int f = 1 - r;
+  int ddFx = 1;
+  int ddFy = -2 * r;
+  int x = 0;
+  int y = r;
+  int px = x;
+  int py = y;
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddFy += 2;
+      f += ddFy;
+    }
+    x++;
+    ddFx += 2;
+    f += ddFx;
+    if (x < y + 1 && y > half[x]) half[x] = y;
+    if (y != py) {
+      if (px > half[py]) half[py] = px;
+      py = y;
+    }
+    px = x;
+  }
+
+  // Each column is drawn exactly once, so INVERSE works too
+  for (int dx = 0; dx <= r; dx++) {
+    fbDrawVLine(display, x0 + dx, y0 - half[dx], 2 * half[dx] + 1, color);
+    if (dx != 0) fbDrawVLine(display, x0 - dx, y0 - half[dx], 2 * half[dx] + 1, color);
+  }
+}
+
+static inline uint32_t loadWord(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, 4); // Source may be unaligned
+  return value;
+}
+
+void fbOrBytes(uint8_t* dst, const uint8_t* src, size_t count) {
+  while (count > 0 && ((uintptr_t)dst & 3) != 0) {
+    *dst++ |= *src++;
+    count--;
+  }
+  for (; count >= 4; count -= 4, dst += 4, src += 4) {
+    *(uint32_t*)dst |= loadWord(src);
+  }
+  while (count-- > 0) {
+    *dst++ |= *src++;
+  }
+}
+
+void fbXorBytes(uint8_t* dst, const uint8_t* src, size_t count) {
+  while (count > 0 && ((uintptr_t)dst & 3) != 0) {
+    *dst++ ^= *src++;
+    count--;
+  }
+  for (; count >= 4; count -= 4, dst += 4, src += 4) {
+    *(uint32_t*)dst ^= loadWord(src);
+  }
+  while (count-- > 0) {
+    *dst++ ^= *src++;
+  }
+}
+
+void fbAndNotBytes(uint8_t* dst, const uint8_t* mask, size_t count) {
+  while (count > 0 && ((uintptr_t)dst & 3) != 0) {
+    *dst++ &= ~*mask++;
+    count--;
+  }
+  for (; count >= 4; count -= 4, dst += 4, mask += 4) {
+    *(uint32_t*)dst &= ~loadWord(mask);
+  }
+  while (count-- > 0) {
+    *dst++ &= ~*mask++;
+  }
+}
+
+static void blitPages(Adafruit_SSD1306* display, const uint8_t* src, int width, int pages,
+                      int x, int page, bool exclusive) {
+  uint8_t* buffer = display->getBuffer();
+  if (buffer == nullptr) return;
+  int panelWidth = display->width();
+  int panelPages = display->height() / 8;
+
+  int first = (x < 0) ? -x : 0;
+  int last = (x + width > panelWidth) ? panelWidth - x : width;
+  if (first >= last) return;
+
+  for (int row = 0; row < pages; row++) {
+    int destPage = page + row;
+    if (destPage < 0 || destPage >= panelPages) continue;
+    uint8_t* dst = buffer + destPage * panelWidth + x + first;
+    const uint8_t* from = src + row * width + first;
+    if (exclusive) {
+      fbXorBytes(dst, from, last - first);
+    } else {
+      fbOrBytes(dst, from, last - first);
+    }
+  }
+}
+
+void fbBlitOr(Adafruit_SSD1306* display, const uint8_t* src, int width, int pages, int x, int page) {
+  blitPages(display, src, width, pages, x, page, false);
+}
+
+void fbBlitXor(Adafruit_SSD1306* display, const uint8_t* src, int width, int pages, int x, int page) {
+  blitPages(display, src, width, pages, x, page, true);
+}
+
+uint32_t fbPopcount(const uint8_t* data, size_t count) {
+  uint32_t total = 0;
+  while (count > 0 && ((uintptr_t)data & 3) != 0) {
+    uint8_t v = *data++;
+    while (v) { v &= v - 1; total++; }
+    count--;
+  }
+
+  // Classic SWAR bit count, four bytes per step
+  for (; count >= 4; count -= 4, data += 4) {
+    uint32_t v = *(const uint32_t*)data;
+    v = v - ((v >> 1) & 0x55555555UL);
+    v = (v & 0x33333333UL) + ((v >> 2) & 0x33333333UL);
+    v = (v + (v >> 4)) & 0x0F0F0F0FUL;
+    total += (uint32_t)(v * 0x01010101UL) >> 24;
+  }
+
+  while (count-- > 0) {
+    uint8_t v = *data++;
+    while (v) { v &= v - 1; total++; }
+  }
+  return total;
+}
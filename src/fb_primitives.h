@@ -0,0 +1,39 @@
+/*
+ * Mochi Robot - Framebuffer Primitives
+ * 1bpp drawing straight on the SSD1306 page buffer, 32 bits at a time
+ *
+ * Each buffer byte is 8 vertical pixels (bit0 on top), so one page row
+ * of 4 columns is a single 32-bit word. Spans and rects repeat a page
+ * mask across those words; vertical lines and filled circles become a
+ * few masked bytes per column. Results match Adafruit GFX pixel for
+ * pixel for SSD1306_WHITE and SSD1306_BLACK.
+ */
+
+#ifndef FB_PRIMITIVES_H
+#define FB_PRIMITIVES_H
+
+#include <Adafruit_SSD1306.h>
+
+#define FB_MAX_CIRCLE_RADIUS 127
+
+// Spans and rectangles (color: SSD1306_WHITE, SSD1306_BLACK or SSD1306_INVERSE)
+void fbDrawHLine(Adafruit_SSD1306* display, int x, int y, int w, uint16_t color);
+void fbDrawVLine(Adafruit_SSD1306* display, int x, int y, int h, uint16_t color);
+void fbFillRect(Adafruit_SSD1306* display, int x, int y, int w, int h, uint16_t color);
+
+// Filled circle built from a per-column span table (same pixels as GFX fillCircle)
+void fbFillCircle(Adafruit_SSD1306* display, int x0, int y0, int r, uint16_t color);
+
+// Page-aligned sprite blits; src holds `pages` rows of `width` page bytes
+void fbBlitOr(Adafruit_SSD1306* display, const uint8_t* src, int width, int pages, int x, int page);
+void fbBlitXor(Adafruit_SSD1306* display, const uint8_t* src, int width, int pages, int x, int page);
+
+// Raw byte runs (whole frames, page rows)
+void fbOrBytes(uint8_t* dst, const uint8_t* src, size_t count);
+void fbXorBytes(uint8_t* dst, const uint8_t* src, size_t count);
+void fbAndNotBytes(uint8_t* dst, const uint8_t* mask, size_t count); // Clear dst where mask is set
+
+// Number of lit pixels in a run of page bytes
+uint32_t fbPopcount(const uint8_t* data, size_t count);
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ * Mochi Robot - Fixed-Point Trigonometry
+ * Compile-time sine table for the FPU-less ESP32-C3
+ *
+ * Angles are whole degrees, results are Q15 (1.0 == 32768).
+ */
+
+#ifndef FIXED_TRIG_H
+#define FIXED_TRIG_H
+
+#include <stdint.h>
+
+#define FIXED_ONE_Q15 32768
+
+// Quarter-wave sine table (0..90 degrees), generated by the compiler
+struct FixedSinTable {
+  uint16_t values[91];
+
+  constexpr FixedSinTable() : values() {
+    for (int deg = 0; deg <= 90; deg++) {
+      // Taylor series, accurate to well below one Q15 step on [0, pi/2]
+      double x = deg * 3.14159265358979323846 / 180.0;
+      double term = x;
+      double sum = x;
+      for (int n = 1; n < 10; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+      }
+      values[deg] = (uint16_t)(sum * FIXED_ONE_Q15 + 0.5);
+    }
+  }
+};
+
+inline constexpr FixedSinTable FIXED_SIN_TABLE{};
+
+static_assert(FIXED_SIN_TABLE.values[0] == 0, "sin(0) must be 0");
+static_assert(FIXED_SIN_TABLE.values[30] == FIXED_ONE_Q15 / 2, "sin(30) must be 0.5");
+static_assert(FIXED_SIN_TABLE.values[90] == FIXED_ONE_Q15, "sin(90) must be 1.0");
+
+// Sine of an angle in degrees (any range), Q15
+inline int32_t fixedSin(int degrees) {
+  degrees %= 360;
+  if (degrees < 0) degrees += 360;
+
+  if (degrees <= 90) return FIXED_SIN_TABLE.values[degrees];
+  if (degrees <= 180) return FIXED_SIN_TABLE.values[180 - degrees];
+  if (degrees <= 270) return -(int32_t)FIXED_SIN_TABLE.values[degrees - 180];
+  return -(int32_t)FIXED_SIN_TABLE.values[360 - degrees];
+}
+
+// Cosine of an angle in degrees (any range), Q15
+inline int32_t fixedCos(int degrees) {
+  return fixedSin(degrees + 90);
+}
+
+// value * q15, truncated toward zero like a float-to-int cast
+inline int32_t fixedMulQ15(int32_t value, int32_t q15) {
+  return (value * q15) / FIXED_ONE_Q15;
+}
+
+#endif
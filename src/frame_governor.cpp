@@ -0,0 +1,101 @@
+/*
+ * Mochi Robot - Frame Governor Implementation
+ */
+
+#include "frame_governor.h"
+
+FrameGovernor::FrameGovernor() {
+  sleeping = false;
+  targetFps = GOVERNOR_ACTIVE_FPS;
+  lastActivity = 0;
+  lastChange = 0;
+  lastFrame = 0;
+  lastFrameCount = 0;
+  windowStart = 0;
+  windowFrames = 0;
+  windowBusyMicros = 0;
+  loopStartMicros = 0;
+  measuredFps = 0;
+  frameCostMicros = 0;
+  loopDutyPercent = 100;
+}
+
+void FrameGovernor::notifyActivity() {
+  lastActivity = millis();
+}
+
+void FrameGovernor::setSleeping(bool isSleeping) {
+  if (isSleeping != sleeping) {
+    sleeping = isSleeping;
+    lastActivity = millis(); // Let the open/close animation play at full rate
+  }
+}
+
+void FrameGovernor::trackFrame(unsigned long framesPresented, bool changed, unsigned long costMicros) {
+  if (framesPresented == lastFrameCount) {
+    return; // Not due yet, nothing rendered
+  }
+  lastFrameCount = framesPresented;
+  lastFrame = millis();
+  windowFrames++;
+  if (changed) {
+    lastChange = lastFrame;
+  }
+
+  // Moving average over ~8 frames
+  frameCostMicros = (frameCostMicros * 7 + costMicros) / 8;
+}
+
+bool FrameGovernor::update() {
+  unsigned long now = millis();
+  uint8_t fps;
+
+  if (now - lastActivity < ACTIVE_HOLD_MS || now - lastChange < CHANGE_HOLD_MS) {
+    fps = GOVERNOR_ACTIVE_FPS; // Transition or animation in progress
+  } else if (sleeping) {
+    fps = GOVERNOR_SLEEP_FPS;
+  } else {
+    fps = GOVERNOR_IDLE_FPS;   // Static picture, still fast enough to catch the next blink
+  }
+
+  if (fps != targetFps) {
+    targetFps = fps;
+    return true;
+  }
+  return false;
+}
+
+unsigned long FrameGovernor::getScreenInterval() {
+  if (millis() - lastActivity < ACTIVE_HOLD_MS) {
+    return GOVERNOR_ACTIVE_SCREEN_INTERVAL;
+  }
+  return GOVERNOR_IDLE_SCREEN_INTERVAL;
+}
+
+void FrameGovernor::beginLoop() {
+  loopStartMicros = micros();
+}
+
+void FrameGovernor::endLoop(unsigned long nextChangeMs) {
+  windowBusyMicros += micros() - loopStartMicros;
+
+  unsigned long now = millis();
+  if (now - windowStart >= 1000) {
+    unsigned long elapsed = now - windowStart;
+    measuredFps = windowFrames * 1000 / elapsed;
+    loopDutyPercent = min(100UL, windowBusyMicros / (elapsed * 10));
+    windowFrames = 0;
+    windowBusyMicros = 0;
+    windowStart = now;
+  }
+
+  // Nap until the next eye frame is due instead of spinning. When the
+  // eyes are not rendering (other screens) this just yields the nap cap.
+  unsigned long interval = 1000 / targetFps;
+  unsigned long nap = interval - (now - lastFrame) % interval;
+  nap = min(nap, sleeping ? MAX_SLEEP_NAP_MS : MAX_NAP_MS);
+  nap = min(nap, nextChangeMs);
+  if (nap > 0) {
+    delay(nap);
+  }
+}
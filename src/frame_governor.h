@@ -0,0 +1,79 @@
+/*
+ * Mochi Robot - Frame Governor
+ * Picks the eye frame rate and screen poll interval from what is on screen
+ *
+ * Frames that change pixels (blinks, idle glances, playLaugh(), mood
+ * transitions) keep the eyes at full rate; once the picture has been
+ * static for a while the rate drops, and it falls to a trickle while
+ * sleeping. Between frames the loop sleeps instead of spinning.
+ */
+
+#ifndef FRAME_GOVERNOR_H
+#define FRAME_GOVERNOR_H
+
+#include <Arduino.h>
+#include "anim_clock.h"
+
+// Eye frame rates
+#define GOVERNOR_ACTIVE_FPS 50
+#define GOVERNOR_IDLE_FPS   12
+#define GOVERNOR_SLEEP_FPS  1
+
+// ScreenManager poll intervals (ms)
+#define GOVERNOR_ACTIVE_SCREEN_INTERVAL 50
+#define GOVERNOR_IDLE_SCREEN_INTERVAL   250
+
+class FrameGovernor {
+private:
+  bool sleeping;
+  uint8_t targetFps;
+  unsigned long lastActivity;  // Touch, screen switch, emotion change
+  unsigned long lastChange;    // Last frame that changed pixels
+  unsigned long lastFrame;
+  unsigned long lastFrameCount;
+
+  // Metrics
+  unsigned long windowStart;
+  unsigned long windowFrames;
+  unsigned long windowBusyMicros;
+  unsigned long loopStartMicros;
+  uint8_t measuredFps;
+  unsigned long frameCostMicros; // Moving average
+  uint8_t loopDutyPercent;
+
+  // Stay at full rate this long after activity or a changed frame
+  static const unsigned long ACTIVE_HOLD_MS = 1500;
+  static const unsigned long CHANGE_HOLD_MS = 400;
+
+  // Longest nap between loop passes (keeps touch polling responsive)
+  static const unsigned long MAX_NAP_MS = 10;
+  static const unsigned long MAX_SLEEP_NAP_MS = 50;
+
+public:
+  FrameGovernor();
+
+  // Inputs
+  void notifyActivity();
+  void setSleeping(bool isSleeping);
+
+  // Call after a render attempt with MochiDisplay's presented-frame count
+  void trackFrame(unsigned long framesPresented, bool changed, unsigned long costMicros);
+
+  // Recompute the target; returns true when the eye frame rate changed
+  bool update();
+
+  uint8_t getTargetFps() { return targetFps; }
+  unsigned long getScreenInterval();
+
+  // Loop duty accounting: mark the start of loop(), then nap at the end.
+  // The nap never runs past nextChangeMs (time until a screen's next visual change).
+  void beginLoop();
+  void endLoop(unsigned long nextChangeMs = ANIM_NO_CHANGE);
+
+  // Metrics
+  uint8_t getMeasuredFps() { return measuredFps; }
+  unsigned long getFrameCostMicros() { return frameCostMicros; }
+  uint8_t getLoopDutyPercent() { return loopDutyPercent; }
+};
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * Mochi Robot - Frame Mirror Implementation
+ */
+
+#include "frame_mirror.h"
+#include "fb_primitives.h"
+#include <errno.h>
+#include <lwip/sockets.h>
+
+size_t packBits(const uint8_t* data, size_t count, uint8_t* out) {
+  size_t i = 0;
+  size_t length = 0;
+  while (i < count) {
+    // Runs start at three equal bytes; shorter ones stay literal so the
+    // output never grows by more than one byte per 128
+    size_t run = 1;
+    while (i + run < count && run < 128 && data[i + run] == data[i]) run++;
+    if (run >= 3) {
+      out[length++] = (uint8_t)(257 - run);
+      out[length++] = data[i];
+      i += run;
+      continue;
+    }
+
+    // Literals up to the next run
+    size_t start = i;
+    while (i < count && i - start < 128) {
+      if (i + 2 < count && data[i + 1] == data[i] && data[i + 2] == data[i]) break;
+      i++;
+    }
+    out[length++] = (uint8_t)(i - start - 1);
+    memcpy(out + length, data + start, i - start);
+    length += i - start;
+  }
+  return length;
+}
+
+FrameMirror::FrameMirror(uint16_t port) : server(port) {
+  this->port = port;
+  started = false;
+  viewerConnected = false;
+  pending = false;
+  keyframe = true;
+  sequence = 0;
+  lastSendTime = 0;
+  queuedLength = 0;
+  queuedSent = 0;
+  packetsSent = 0;
+  bytesSent = 0;
+  lastPacketBytes = 0;
+  memset(latest, 0, sizeof(latest));
+  memset(sent, 0, sizeof(sent));
+}
+
+void FrameMirror::capture(const uint8_t* frame) {
+  if (memcmp(latest, frame, Panel::frameBytes) == 0) return;
+  memcpy(latest, frame, Panel::frameBytes);
+  pending = true;
+}
+
+void FrameMirror::resetReference() {
+  memset(sent, 0, sizeof(sent));
+  keyframe = true;
+  pending = true;
+}
+
+size_t FrameMirror::encodePacket() {
+  // XOR delta: unchanged bytes become zero runs
+  memcpy(delta, latest, Panel::frameBytes);
+  fbXorBytes(delta, sent, Panel::frameBytes);
+  size_t payload = packBits(delta, Panel::frameBytes, packet + MIRROR_HEADER_BYTES);
+  memcpy(sent, latest, Panel::frameBytes);
+
+  packet[0] = 'M';
+  packet[1] = 'F';
+  packet[2] = keyframe ? MIRROR_FLAG_KEYFRAME : 0;
+  packet[3] = sequence++;
+  packet[4] = Panel::width;
+  packet[5] = Panel::height;
+  packet[6] = payload & 0xFF;
+  packet[7] = payload >> 8;
+  keyframe = false;
+  pending = false;
+  return MIRROR_HEADER_BYTES + payload;
+}
+
+// Room in the socket's send buffer, without waiting for it
+bool FrameMirror::canWrite() {
+  int fd = client.fd();
+  if (fd < 0) return false;
+  fd_set writable;
+  FD_ZERO(&writable);
+  FD_SET(fd, &writable);
+  struct timeval none = {0, 0};
+  return select(fd + 1, nullptr, &writable, nullptr, &none) > 0;
+}
+
+// Hand the socket as much of the queued packet as it takes right now
+void FrameMirror::sendQueued() {
+  int written = send(client.fd(), packet + queuedSent, queuedLength - queuedSent, MSG_DONTWAIT);
+  if (written < 0) {
+    if (errno == EWOULDBLOCK || errno == EAGAIN) return;
+    client.stop(); // Viewer gone; it can reconnect for a keyframe
+    viewerConnected = false;
+    queuedLength = 0;
+    queuedSent = 0;
+    return;
+  }
+  queuedSent += written;
+  if (queuedSent < queuedLength) return;
+
+  packetsSent++;
+  bytesSent += queuedLength;
+  lastPacketBytes = queuedLength;
+  queuedLength = 0;
+  queuedSent = 0;
+}
+
+void FrameMirror::update(const uint8_t* current) {
+  if (!started) {
+    server.begin();
+    server.setNoDelay(true);
+    started = true;
+    Serial.print("🪞 Frame mirror on port ");
+    Serial.println(port);
+  }
+
+  // One viewer at a time; a new connection replaces the old one
+  WiFiClient incoming = server.available();
+  if (incoming) {
+    client.stop();
+    client = incoming;
+    client.setNoDelay(true);
+    queuedLength = 0;
+    queuedSent = 0;
+    capture(current); // Frames are only captured while someone watches
+    resetReference();
+    Serial.print("🪞 Mirror viewer: ");
+    Serial.println(client.remoteIP());
+  }
+  viewerConnected = client.connected();
+  if (!viewerConnected) return;
+
+  // Finish the packet the socket only partly took before building another
+  if (queuedSent < queuedLength) {
+    sendQueued();
+    return;
+  }
+  if (!pending) return;
+
+  unsigned long now = millis();
+  if (now - lastSendTime < 1000 / MIRROR_MAX_FPS) return;
+  if (!canWrite()) return; // Viewer behind: skip this frame
+  lastSendTime = now;
+
+  queuedLength = encodePacket();
+  queuedSent = 0;
+  sendQueued();
+}
@@ -0,0 +1,93 @@
+/*
+ * Mochi Robot - Frame Mirror
+ * Streams what is on the OLED to one TCP viewer (scripts/mirror_viewer.py)
+ *
+ * While a viewer is connected MochiDisplay::display() hands every frame to
+ * capture(); update() sends the latest one at most MIRROR_MAX_FPS times a
+ * second. Each packet is the XOR of the frame against the last one sent,
+ * PackBits-compressed, so an unchanged page costs a few bytes and a still
+ * screen costs nothing. A new viewer first gets a keyframe of what the
+ * panel shows (delta against a blank frame).
+ *
+ * update() never blocks loop(): while the socket's send buffer is full no
+ * packet is built (the frames in between are dropped, the next packet
+ * carries their changes), and a packet the socket only partly took is
+ * finished on later calls.
+ *
+ * Packet: 'M' 'F' flags seq width height length(LE16) payload
+ */
+
+#ifndef FRAME_MIRROR_H
+#define FRAME_MIRROR_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "display_geometry.h"
+
+#define MIRROR_PORT 3333
+#define MIRROR_MAX_FPS 20
+#define MIRROR_HEADER_BYTES 8
+#define MIRROR_FLAG_KEYFRAME 0x01
+
+// PackBits never grows data by more than one byte per 128
+#define MIRROR_MAX_PAYLOAD (Panel::frameBytes + Panel::frameBytes / 128 + 1)
+
+// Classic PackBits (same format as the asset compiler): n < 128 -> n+1
+// literal bytes, n > 128 -> next byte repeated 257-n times. Returns the
+// encoded size; out needs count + count / 128 + 1 bytes.
+size_t packBits(const uint8_t* data, size_t count, uint8_t* out);
+
+class FrameMirror {
+private:
+  WiFiServer server;
+  WiFiClient client;
+  uint16_t port;
+  bool started;
+  bool viewerConnected;
+  bool pending;  // latest differs from what the viewer has
+  bool keyframe; // Next packet resets the viewer
+  uint8_t sequence;
+  unsigned long lastSendTime;
+  size_t queuedLength; // Packet waiting for the socket (0 when none)
+  size_t queuedSent;   // Bytes of it the socket has taken
+
+  uint8_t latest[Panel::frameBytes]; // Last captured frame
+  uint8_t sent[Panel::frameBytes];   // What the viewer shows
+  uint8_t delta[Panel::frameBytes];
+  uint8_t packet[MIRROR_HEADER_BYTES + MIRROR_MAX_PAYLOAD];
+
+  bool canWrite();
+  void sendQueued();
+
+  // Statistics
+  unsigned long packetsSent;
+  unsigned long bytesSent;
+  size_t lastPacketBytes;
+
+public:
+  FrameMirror(uint16_t port = MIRROR_PORT);
+
+  // Frame hook, called from MochiDisplay::display(); one compare and copy
+  void capture(const uint8_t* frame);
+
+  // Accept a viewer and send the pending frame (call from loop() while WiFi
+  // is up); `current` is what the panel shows, the keyframe for a new viewer
+  void update(const uint8_t* current);
+
+  // Build the packet for the latest frame and advance the reference.
+  // Returns the packet size; the bytes are at getPacket().
+  size_t encodePacket();
+  const uint8_t* getPacket() { return packet; }
+
+  // Forget the reference: the next packet is a keyframe
+  void resetReference();
+
+  bool hasViewer() { return viewerConnected; }
+
+  // Statistics
+  unsigned long getPacketsSent() { return packetsSent; }
+  unsigned long getBytesSent() { return bytesSent; }
+  size_t getLastPacketBytes() { return lastPacketBytes; }
+};
+
+#endif
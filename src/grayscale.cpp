@@ -0,0 +1,83 @@
+/*
+ * Mochi Robot - Grayscale Implementation
+ */
+
+#include "grayscale.h"
+
+Grayscale::Grayscale() {
+  memset(high, 0, sizeof(high));
+  memset(low, 0, sizeof(low));
+  memset(subframe, 0, sizeof(subframe));
+  phase = GRAY_PLAIN_SUBFRAME;
+  grayPages = 0;
+}
+
+void Grayscale::findGrayPages() {
+  grayPages = 0;
+  for (int page = 0; page < Panel::pages; page++) {
+    const uint8_t* h = high + page * Panel::width;
+    const uint8_t* l = low + page * Panel::width;
+    for (int col = 0; col < Panel::width; col++) {
+      if (h[col] != l[col]) {
+        grayPages |= 1 << page;
+        break;
+      }
+    }
+  }
+}
+
+void Grayscale::setPlanes(const uint8_t* highPlane, const uint8_t* lowPlane) {
+  memcpy(high, highPlane, Panel::frameBytes);
+  memcpy(low, lowPlane, Panel::frameBytes);
+  findGrayPages();
+  phase = GRAY_PLAIN_SUBFRAME;
+}
+
+void Grayscale::smoothEdges(const uint8_t* frame) {
+  memcpy(high, frame, Panel::frameBytes);
+
+  // Dilate by one pixel in page bytes: up/down is a shift within the byte
+  // plus the neighbouring page's edge bit, left/right the next column
+  for (int page = 0; page < Panel::pages; page++) {
+    const uint8_t* row = frame + page * Panel::width;
+    const uint8_t* above = (page > 0) ? row - Panel::width : nullptr;
+    const uint8_t* below = (page < Panel::pages - 1) ? row + Panel::width : nullptr;
+    uint8_t* out = low + page * Panel::width;
+
+    for (int col = 0; col < Panel::width; col++) {
+      uint8_t bits = row[col];
+      uint8_t grown = bits | (uint8_t)(bits << 1) | (bits >> 1);
+      if (above != nullptr) grown |= above[col] >> 7;
+      if (below != nullptr) grown |= (uint8_t)(below[col] << 7);
+      if (col > 0) grown |= row[col - 1];
+      if (col < Panel::width - 1) grown |= row[col + 1];
+      out[col] = grown;
+    }
+  }
+
+  findGrayPages();
+  phase = GRAY_PLAIN_SUBFRAME; // high == frame, which is on the panel
+}
+
+const uint8_t* Grayscale::getSubframe(uint8_t index) {
+  if (index == 0) {
+    for (int i = 0; i < Panel::frameBytes; i++) subframe[i] = high[i] | low[i];
+  } else if (index == 1) {
+    memcpy(subframe, high, Panel::frameBytes);
+  } else {
+    for (int i = 0; i < Panel::frameBytes; i++) subframe[i] = high[i] & low[i];
+  }
+  return subframe;
+}
+
+const uint8_t* Grayscale::nextSubframe() {
+  phase = (phase + 1) % GRAY_SUBFRAMES;
+  return getSubframe(phase);
+}
+
+uint8_t Grayscale::getLevel(int x, int y) {
+  if (x < 0 || x >= Panel::width || y < 0 || y >= Panel::height) return 0;
+  int index = x + (y / 8) * Panel::width;
+  uint8_t bit = 1 << (y & 7);
+  return ((high[index] & bit) ? 2 : 0) + ((low[index] & bit) ? 1 : 0);
+}
@@ -0,0 +1,69 @@
+/*
+ * Mochi Robot - Grayscale
+ * 4-level grayscale on the 1bpp SSD1306 by cycling bit-plane subframes
+ *
+ * A gray frame is two planes, high (weight 2) and low (weight 1). Level
+ * v = 0..3 is lit in v of the GRAY_SUBFRAMES subframes:
+ *   subframe 0 = high | low, subframe 1 = high, subframe 2 = high & low
+ * MochiDisplay's flush task shows them in turn every GRAY_SUBFRAME_MS.
+ * Pixels at level 0 or 3 are the same in every subframe, so the diff
+ * flush only sends the pages that hold gray pixels.
+ *
+ * smoothEdges() builds the planes from a plain frame: lit pixels stay at
+ * 3 and unlit pixels touching them get level 1, which softens the edges
+ * of EyeEngine and EmojiDrawer faces without changing how they draw.
+ *
+ * Off unless built with -DMOCHI_GRAYSCALE=1.
+ */
+
+#ifndef GRAYSCALE_H
+#define GRAYSCALE_H
+
+#include <Arduino.h>
+#include "display_geometry.h"
+
+#ifndef MOCHI_GRAYSCALE
+#define MOCHI_GRAYSCALE 0
+#endif
+
+#define GRAY_SUBFRAMES 3
+#define GRAY_SUBFRAME_MS 8     // About 42 full gray cycles per second
+#define GRAY_PLAIN_SUBFRAME 1  // The high plane: what 1bpp output of the frame looks like
+
+static_assert(Panel::pages <= 8, "Gray page mask holds 8 pages");
+
+class Grayscale {
+private:
+  uint8_t high[Panel::frameBytes];
+  uint8_t low[Panel::frameBytes];
+  uint8_t subframe[Panel::frameBytes];
+  uint8_t phase;     // Subframe the panel shows
+  uint8_t grayPages; // One bit per page that holds level 1 or 2 pixels
+
+  void findGrayPages();
+
+public:
+  Grayscale();
+
+  // Load both planes (Panel::frameBytes each, SSD1306 page layout)
+  void setPlanes(const uint8_t* highPlane, const uint8_t* lowPlane);
+
+  // Planes from a 1bpp frame: lit pixels at level 3, their unlit
+  // 4-neighbours at level 1. The panel is assumed to show the plain frame.
+  void smoothEdges(const uint8_t* frame);
+
+  // True if the subframes differ at all (otherwise there is nothing to cycle)
+  bool hasGray() { return grayPages != 0; }
+  uint8_t getGrayPages() { return grayPages; }
+
+  // Build one subframe (0..GRAY_SUBFRAMES-1); valid until the next call
+  const uint8_t* getSubframe(uint8_t index);
+
+  // The subframe after the one on the panel
+  const uint8_t* nextSubframe();
+
+  // Gray level 0..3 of one pixel
+  uint8_t getLevel(int x, int y);
+};
+
+#endif
@@ -13,10 +13,10 @@
 #include <WiFiUdp.h>
 #include <HTTPClient.h>
 #include <time.h>
-// Include ArduinoJson explicitly first to avoid macro conflicts
 #include <ArduinoJson.h>
-// Now include RoboEyes (which defines N and E macros)
-#include "../RoboEyes/src/FluxGarage_RoboEyes.h"
+#include "display_flush.h"
+#include "mochi_display.h"
+#include "compositor.h"
 #include "screen_manager.h"
 #include "touch_handler.h"
 #include "emotion_manager.h"
@@ -24,13 +24,19 @@
 #include "prayer_api.h"
 #include "display_brightness.h"
 #include "ble_setup.h"
+#include "fixed_trig.h"
+#include "frame_governor.h"
+#include "boot_frame.h"
+#include "frame_mirror.h"
+#include "grayscale.h"
+#include "emotion_fade.h"
+#include "eye_engine.h"
+#include "sleep_screensaver.h"
 
-// Display setup
-#define SCREEN_WIDTH 128
-#define SCREEN_HEIGHT 64
+// Display setup (panel size comes from display_geometry.h / build flags)
 #define OLED_RESET    -1
 #define SCREEN_ADDRESS 0x3C
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+MochiDisplay display(&Wire, OLED_RESET);
 
 // Touch sensor
 #define TOUCH_PIN 2
@@ -39,19 +45,43 @@ Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 #define BUZZER_PIN 4
 #define BUZZER_CHANNEL 0
 
-// RoboEyes instance
-RoboEyes<Adafruit_SSD1306> roboEyes(display);
+// Robot eyes, drawn straight into the display's back buffer
+EyeEngine<MochiDisplay> eyeEngine(display);
 
 // Preferences for NVS storage
 Preferences preferences;
 
+// Dirty-page flush layer (only changed SSD1306 pages go over I2C)
+DisplayFlush displayFlush(display.canvas(), SCREEN_ADDRESS);
+
+// Status bar overlay, stamped onto every frame by display.display()
+Compositor compositor;
+
+#if MOCHI_GRAYSCALE
+// Soft-edged eyes: gray subframes cycled by the flush task
+Grayscale grayscale;
+#endif
+
+// Remote view of the panel (scripts/mirror_viewer.py)
+FrameMirror frameMirror;
+
+// Dithered cross-fade between faces on emotion changes
+EmotionFade emotionFade;
+
+// Stars and Zzz left scrolling by the panel itself while asleep
+SleepScreensaver sleepScreensaver(TOUCH_PIN);
+
+// Last frame and emotion, shown again right after power-on
+BootFrame bootFrame(&preferences);
+
 // Manager instances
-ScreenManager screenManager(&display);
+ScreenManager screenManager(&display, &compositor);
 TouchHandler touchHandler(TOUCH_PIN);
-EmotionManager emotionManager(&roboEyes);
+EmotionManager emotionManager(&eyeEngine);
 WeatherAPI weatherAPI(&preferences);
 PrayerAPI prayerAPI(&preferences);
-DisplayBrightness displayBrightness(&display);
+DisplayBrightness displayBrightness(display.canvas());
+FrameGovernor frameGovernor;
 BleSetup bleSetup(&preferences);
 
 // State management
@@ -59,6 +89,7 @@ bool wifiConnected = false;
 bool isSleeping = false;
 unsigned long lastInteractionTime = 0;
 unsigned long sleepTimeout = 300000; // 5 minutes default
+unsigned long lastTapWaitMillis = 0;  // Release to tap event (double tap window)
 
 // WiFi Configuration Storage
 bool isConfigured = false;
@@ -85,29 +116,45 @@ void initNTP();
 
 void setup() {
   Serial.begin(115200);
-  delay(1000);
   
-  Serial.println("=== Mochi Robot Starting ===");
-  
-  // Initialize Display
-  Serial.println("Initializing Display...");
+  // Display first: put the last frame back on the panel before anything slow
   Wire.begin(8, 9);
   if(!display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS)) {
     Serial.println("Display FAILED!");
     for(;;);
   }
   display.clearDisplay();
+  if (bootFrame.restore()) {
+    memcpy(display.getBuffer(), bootFrame.getFrame(), Panel::frameBytes);
+  }
   display.display();
+  display.holdFrame(true); // Keep it up until setup() is done
+  bootFrame.markPhase("display + boot frame");
+  
+  delay(1000); // Let the USB serial console attach
+  bootFrame.markPhase("serial");
+  
+  Serial.println("=== Mochi Robot Starting ===");
+  
+  Serial.println("Initializing Display...");
+#if MOCHI_GRAYSCALE
+  display.setGrayscale(&grayscale);
+  display.setGrayscaleEnabled(true);
+#endif
+  if (!display.startFlushTask(&displayFlush)) {
+    Serial.println("Display flush task FAILED, using blocking writes");
+  }
+  display.setCompositor(&compositor);
+  display.setMirror(&frameMirror);
   Serial.println("Display: OK");
   
-  // Initialize RoboEyes
-  Serial.println("Initializing RoboEyes...");
-  roboEyes.begin(SCREEN_WIDTH, SCREEN_HEIGHT, 50); // 50 FPS
-  roboEyes.setDisplayColors(0, 1); // Black background, white eyes
-  roboEyes.setAutoblinker(ON, 3, 2); // Auto blink every 3-5 seconds
-  roboEyes.setIdleMode(ON, 5, 3); // Idle mode: look around every 5-8 seconds
-  roboEyes.setMood(DEFAULT);
-  Serial.println("RoboEyes: OK");
+  // Initialize the eyes
+  Serial.println("Initializing eyes...");
+  eyeEngine.begin(GOVERNOR_ACTIVE_FPS); // FrameGovernor adjusts this at runtime
+  eyeEngine.setAutoblinker(true, 3, 2); // Auto blink every 3-5 seconds
+  eyeEngine.setIdleMode(true, 5, 3); // Idle mode: look around every 5-8 seconds
+  Serial.println("Eyes: OK");
+  bootFrame.markPhase("Eyes");
   
   // Initialize Touch
   Serial.println("Initializing Touch Sensor...");
@@ -129,6 +176,7 @@ void setup() {
     Serial.println("⚠️ BLE init failed, continuing without setup mode");
     screenManager.setBluetoothEnabled(false);
   }
+  bootFrame.markPhase("BLE");
   
   // Load setup data from NVS
   if (bleSetup.getSetupData(&setupData)) {
@@ -153,17 +201,18 @@ void setup() {
   
   // Initialize WiFi
   initWiFi();
+  bootFrame.markPhase("WiFi");
   
   // Initialize NTP if WiFi connected
   if (wifiConnected) {
     initNTP();
+    bootFrame.markPhase("NTP");
   }
   
   // Load cached weather and prayer data
   weatherAPI.loadCachedWeather(&currentWeather);
-  if (currentWeather.temperature != 0.0 || currentWeather.condition.length() > 0) {
-    screenManager.setWeather(currentWeather.temperature, currentWeather.condition, 
-                           currentWeather.icon, currentWeather.cached);
+  if (currentWeather.temperature != 0.0 || currentWeather.condition != WEATHER_UNKNOWN) {
+    screenManager.setWeather(currentWeather.temperature, currentWeather.condition, currentWeather.cached);
   }
   
   prayerAPI.loadCachedPrayerTimes(&currentPrayer);
@@ -176,8 +225,13 @@ void setup() {
   // Initialize random seed for random emotions
   randomSeed(analogRead(A0) + millis());
   
-  // Set initial emotion
-  emotionManager.setNeutral();
+  // Set initial emotion: pick up where the boot frame left off
+  emotionManager.setFade(&emotionFade);
+  if (bootFrame.wasRestored()) {
+    emotionManager.setEmotion((MochiEmotion)bootFrame.getEmotion(), 3000);
+  } else {
+    emotionManager.setNeutral();
+  }
   emotionManager.setOnline(wifiConnected);
   emotionManager.enableRandomEmotions(true); // Enable random emotions
   
@@ -201,12 +255,18 @@ void setup() {
     // Weather will be fetched once API key is set via Bluetooth
     Serial.println("🌤️ Weather API key needed (set via Bluetooth)");
   }
+  bootFrame.markPhase("cached data + APIs");
   
   // Play startup beep
   generateTone(600, 200);
   delay(100);
   generateTone(700, 200);
   
+  // Live rendering takes over from the boot frame
+  display.holdFrame(false);
+  bootFrame.markPhase("ready");
+  bootFrame.printReport();
+  
   Serial.println("=== Mochi Robot Ready ===");
   Serial.println("Touch to interact");
   Serial.println("Single tap: Next screen");
@@ -222,6 +282,7 @@ void setup() {
 }
 
 void loop() {
+  frameGovernor.beginLoop();
   unsigned long now = millis();
   
   // Update touch handler
@@ -236,9 +297,33 @@ void loop() {
   // Update emotion manager
   emotionManager.update();
   
+  // Emotion changes (touch or random) start a transition: render at full rate
+  static MochiEmotion lastEmotion = EMO_NEUTRAL;
+  if (emotionManager.getCurrentEmotion() != lastEmotion) {
+    lastEmotion = emotionManager.getCurrentEmotion();
+    frameGovernor.notifyActivity();
+  }
+  
+  // Pace the eyes and screens from what is actually on screen
+  frameGovernor.setSleeping(isSleeping);
+#if MOCHI_GRAYSCALE
+  display.setGrayscaleEnabled(!isSleeping); // No subframe traffic while asleep
+#endif
+  if (frameGovernor.update()) {
+    eyeEngine.setFramerate(frameGovernor.getTargetFps());
+  }
+  screenManager.setUpdateInterval(frameGovernor.getScreenInterval());
+  
   // Update display brightness (for dimming animation)
   displayBrightness.update();
   
+  // Power limiter: count the lit pixels of every new frame
+  static unsigned long lastPowerFrame = 0;
+  if (display.getFramesPresented() != lastPowerFrame) {
+    lastPowerFrame = display.getFramesPresented();
+    displayBrightness.trackFrame(display.getFrame(), Panel::frameBytes);
+  }
+  
   // Check for new setup data from BLE and reconnect WiFi if needed
   static unsigned long lastBTCheck = 0;
   if (bleSetup.getIsEnabled() && (now - lastBTCheck > 2000)) {
@@ -263,12 +348,26 @@ void loop() {
     lastBTCheck = now;
   }
   
-  // Update RoboEyes (only on robot eyes screen and when awake)
+  // Update the eyes (only on robot eyes screen and when awake).
+  // While the previous frame is still on the bus, skip instead of blocking.
   if (screenManager.getCurrentScreen() == SCREEN_ROBOT_EYES && !isSleeping) {
-    roboEyes.update();
-  } else if (!isSleeping) {
-    // Update other screens (only when awake)
-    screenManager.update();
+    if (!display.isFrameInFlight()) {
+      unsigned long frameStart = micros();
+      bool fading = emotionFade.isActive();
+      display.setFade(&emotionFade); // Only eye frames are cross-faded
+      eyeEngine.update();
+      display.setFade(nullptr);
+      if (fading) eyeEngine.invalidate(); // Blended pixels outside the eye boxes
+      frameGovernor.trackFrame(display.getFramesPresented(), display.getLastFrameChanged(),
+                               micros() - frameStart);
+    }
+  } else {
+    emotionFade.cancel(); // No fading from a stale face when the eyes come back
+    eyeEngine.invalidate(); // The buffer will hold another screen
+    if (!isSleeping) {
+      // Update other screens (only when awake)
+      screenManager.update();
+    }
   }
   
   // Bluetooth setup is handled in bluetoothSetup.update() above
@@ -302,14 +401,12 @@ void loop() {
   if (wifiConnected && weatherAPI.needsUpdate() && (now - lastWeatherUpdate > 1800000)) {
     Serial.println("🌤️ Updating weather...");
     if (weatherAPI.fetchWeather(&currentWeather)) {
-      screenManager.setWeather(currentWeather.temperature, currentWeather.condition,
-                              currentWeather.icon, currentWeather.cached);
+      screenManager.setWeather(currentWeather.temperature, currentWeather.condition, currentWeather.cached);
       Serial.println("✅ Weather updated");
     } else {
       // Load cached weather if fetch failed
       if (weatherAPI.loadCachedWeather(&currentWeather)) {
-        screenManager.setWeather(currentWeather.temperature, currentWeather.condition,
-                                currentWeather.icon, true);
+        screenManager.setWeather(currentWeather.temperature, currentWeather.condition, true);
       }
     }
     lastWeatherUpdate = now;
@@ -368,12 +465,137 @@ void loop() {
     screenManager.setWiFiInfo(WiFi.SSID(), WiFi.localIP().toString(), WiFi.RSSI());
   }
   
-  // Update Bluetooth status in settings (BLE)
+  // Update Bluetooth status and the panel current estimate in settings
   static unsigned long lastBTStatusUpdate = 0;
   if (now - lastBTStatusUpdate > 5000) {
     screenManager.setBluetoothEnabled(bleSetup.getIsEnabled());
+    screenManager.setPanelCurrent(displayBrightness.getEstimatedMicroamps());
     lastBTStatusUpdate = now;
   }
+  
+  // Log frame pacing metrics
+  static unsigned long lastGovernorLog = 0;
+  if (now - lastGovernorLog > 60000) {
+    Serial.print("🎞️ FPS: ");
+    Serial.print(frameGovernor.getMeasuredFps());
+    Serial.print(" (target ");
+    Serial.print(frameGovernor.getTargetFps());
+    Serial.print("), frame: ");
+    Serial.print(frameGovernor.getFrameCostMicros());
+    Serial.print(" us, loop duty: ");
+    Serial.print(frameGovernor.getLoopDutyPercent());
+    Serial.println("%");
+    
+    // Tap-to-photon: double tap window, then render and hand-off of the new screen
+    Serial.print("👆 Tap-to-photon: ");
+    Serial.print(lastTapWaitMillis * 1000 + screenManager.getSwitchLatencyMicros() + display.getLastFlushMicros());
+    Serial.print(" us (switch ");
+    Serial.print(screenManager.getSwitchLatencyMicros());
+    Serial.print(" us, ");
+    Serial.print(screenManager.wasLastSwitchPrerendered() ? "pre-rendered" : "rendered");
+    Serial.print("), pre-render hits/misses: ");
+    Serial.print(screenManager.getPrerenderHits());
+    Serial.print("/");
+    Serial.println(screenManager.getPrerenderMisses());
+    
+    Serial.print("📉 Flush: ");
+    Serial.print(displayFlush.getFlushCount());
+    Serial.print(" flushes, ");
+    Serial.print(displayFlush.getBytesSent());
+    Serial.print(" bytes sent, ");
+    Serial.print(displayFlush.getBytesSaved());
+    Serial.print(" saved (");
+    Serial.print(displayFlush.getBytesSavedPerSecond());
+    Serial.print(" bytes/s), gray subframes: ");
+    Serial.print(display.getGraySubframesSent());
+    Serial.print(" (");
+    Serial.print(displayFlush.getSubframeBytesSent());
+    Serial.println(" bytes)");
+    
+    if (frameMirror.hasViewer()) {
+      Serial.print("🪞 Mirror: ");
+      Serial.print(frameMirror.getPacketsSent());
+      Serial.print(" packets, ");
+      Serial.print(frameMirror.getBytesSent());
+      Serial.print(" bytes, last ");
+      Serial.print(frameMirror.getLastPacketBytes());
+      Serial.println(" bytes");
+    }
+    
+    Serial.print("👀 Eyes: ");
+    Serial.print(eyeEngine.getFramesDrawn());
+    Serial.print(" frames drawn, ");
+    Serial.print(eyeEngine.getFramesSkipped());
+    Serial.println(" unchanged");
+    
+    Serial.print("🎭 Emotion fades: ");
+    Serial.print(emotionFade.getFadesStarted());
+    Serial.print(", last blend ");
+    Serial.print(emotionFade.getLastBlendMicros());
+    Serial.println(" us");
+    
+    if (sleepScreensaver.getLightSleepCount() > 0) {
+      Serial.print("💤 Light sleep: ");
+      Serial.print(sleepScreensaver.getLightSleepCount());
+      Serial.print(" naps, ");
+      Serial.print(sleepScreensaver.getLightSleepMillis());
+      Serial.println(" ms asleep");
+    }
+    
+    ParticleSystem* particles = screenManager.getWeatherParticles();
+    if (particles->isAnimated()) {
+      Serial.print("🌧️ Weather particles: ");
+      Serial.print(particles->getCount());
+      Serial.print("/");
+      Serial.print(particles->getTargetCount());
+      Serial.print(", ");
+      Serial.print(particles->getLastFrameMicros());
+      Serial.print(" us/frame (budget ");
+      Serial.print(particles->getBudgetMicros());
+      Serial.println(" us)");
+    }
+    
+    Serial.print("🔋 OLED: ");
+    Serial.print(displayBrightness.getEstimatedMicroamps() / 1000.0, 1);
+    Serial.print(" mA, ");
+    Serial.print(displayBrightness.getLitPixels());
+    Serial.print(" px lit, contrast ");
+    Serial.print(displayBrightness.getAppliedContrast());
+    Serial.println(displayBrightness.isPowerLimited() ? " (limited)" : "");
+    lastGovernorLog = now;
+  }
+  
+  // Stream the panel to a connected mirror viewer
+  if (wifiConnected) {
+    frameMirror.update(display.getPanelFrame());
+  }
+  
+  // Snapshot the face or clock for the next boot (RTC now, flash now and then)
+  static unsigned long lastBootCapture = 0;
+  ScreenType shown = screenManager.getCurrentScreen();
+  if (!isSleeping && (shown == SCREEN_ROBOT_EYES || shown == SCREEN_CLOCK) &&
+      now - lastBootCapture > BOOT_FRAME_CAPTURE_INTERVAL) {
+    time_t wallClock;
+    time(&wallClock);
+    bootFrame.capture(display.getFrame(), emotionManager.getCurrentEmotion(), wallClock);
+    lastBootCapture = now;
+  }
+  bootFrame.save();
+  
+  // Spend idle time pre-rendering the screens a tap can switch to
+  if (!isSleeping) {
+    screenManager.prerenderIdle();
+  }
+  
+  // Sleep until the next frame or screen change is due instead of spinning
+  bool showingEyes = screenManager.getCurrentScreen() == SCREEN_ROBOT_EYES;
+  frameGovernor.endLoop(showingEyes ? ANIM_NO_CHANGE : screenManager.getTimeToNextChange());
+  
+  // Behind the screensaver nothing is drawn: light-sleep until the next
+  // housekeeping tick or a touch (BLE advertising would stop)
+  if (sleepScreensaver.isShown() && !bleSetup.getIsEnabled()) {
+    sleepScreensaver.lightSleep(&display, SCREENSAVER_SLEEP_MS);
+  }
 }
 
 void handleTouchEvents() {
@@ -386,7 +608,9 @@ void handleTouchEvents() {
   // Wake up if sleeping
   if (isSleeping) {
     isSleeping = false;
-    roboEyes.open();
+    lastInteractionTime = millis(); // Or the timeout sends it straight back to sleep
+    sleepScreensaver.hide(&display);
+    eyeEngine.open();
     displayBrightness.brighten(1000); // Brighten over 1 second
     generateTone(700, 200);
     delay(100);
@@ -401,6 +625,10 @@ void handleTouchEvents() {
   // Play purr sound on any touch (like a cat!)
   purrSound();
   
+  frameGovernor.notifyActivity();
+  // Long presses fire while the finger is still down: no tap wait
+  lastTapWaitMillis = (event == TOUCH_LONG_PRESS) ? 0 : millis() - touchHandler.getLastReleaseTime();
+  
   // Handle settings screen navigation differently
   if (screenManager.getCurrentScreen() == SCREEN_SETTINGS) {
     switch(event) {
@@ -411,7 +639,7 @@ void handleTouchEvents() {
         break;
         
       case TOUCH_LONG_PRESS:
-        screenManager.setScreen(SCREEN_ROBOT_EYES);
+        screenManager.setScreen(SCREEN_ROBOT_EYES, TRANSITION_SCROLL_RIGHT);
         generateTone(300, 200);
         Serial.println("👆 Long press - Exit settings");
         break;
@@ -437,7 +665,7 @@ void handleTouchEvents() {
         break;
         
       case TOUCH_LONG_PRESS:
-        screenManager.setScreen(SCREEN_SETTINGS);
+        screenManager.setScreen(SCREEN_SETTINGS, TRANSITION_SCROLL_LEFT);
         generateTone(300, 300);
         Serial.println("👆 Long press - Settings");
         break;
@@ -459,16 +687,21 @@ void updateSleepState() {
   // Check if should sleep
   if (!isSleeping && (now - lastInteractionTime) > sleepTimeout) {
     isSleeping = true;
-    roboEyes.close();
+    eyeEngine.close();
     displayBrightness.dim(2000); // Dim over 2 seconds
     generateTone(400, 300); // Sleep beep
     Serial.println("😴 Going to sleep...");
-    // TODO: Enter light sleep mode (esp_sleep)
+    bootFrame.save(true); // Power may go away while asleep
+    sleepScreensaver.render(now);
   }
   
-  // Check if should wake (handled in touch events, but ensure brightness is restored)
-  if (isSleeping && displayBrightness.getIsDimmed()) {
-    // Keep dimmed while sleeping
+  // Once dimmed, hand the panel the screensaver; loop() light-sleeps behind
+  // it (waking is handled in touch events)
+  if (isSleeping && displayBrightness.getIsDimmed() && !sleepScreensaver.isShown()) {
+    if (sleepScreensaver.show(&display)) {
+      Serial.print("💤 Screensaver up, ");
+      Serial.println(bleSetup.getIsEnabled() ? "no light sleep while BLE setup is on" : "light-sleeping");
+    }
   }
 }
 
@@ -488,8 +721,8 @@ void purrSound() {
   const int modFreqMs = duration / steps;
   
   for (int i = 0; i < steps; i++) {
-    float phase = (float)i / steps;
-    float freq = baseFreq + modDepth * sinf(2.0f * PI * phase);
+    int phaseDegrees = i * 360 / steps;
+    int freq = baseFreq + fixedMulQ15(modDepth, fixedSin(phaseDegrees));
     ledcWriteTone(BUZZER_CHANNEL, (uint32_t)freq);
     delay(modFreqMs);
   }
@@ -0,0 +1,174 @@
+/*
+ * Mochi Robot - Double-Buffered Display Implementation
+ */
+
+#include "mochi_display.h"
+#include "frame_mirror.h"
+#include "emotion_fade.h"
+
+alignas(4) uint8_t MochiDisplay::backBuffer[Panel::frameBytes];
+
+MochiDisplay::MochiDisplay(TwoWire* twi, int8_t resetPin)
+  // Both clocks at FLUSH_I2C_HZ: with Adafruit's default clkAfter every
+  // transfer would leave the bus at 100 kHz, and each frame the flush task
+  // sends afterwards (DisplayFlush uses Wire directly) would go out at a
+  // quarter of the speed of a plain Adafruit display()
+  : Adafruit_SSD1306(Panel::width, Panel::height, twi, resetPin, FLUSH_I2C_HZ, FLUSH_I2C_HZ) {
+  buffer = backBuffer; // Adafruit only mallocs in begin() when this is null
+  flush = nullptr;
+  compositor = nullptr;
+  mirror = nullptr;
+  fade = nullptr;
+  grayscale = nullptr;
+  grayscaleEnabled = false;
+  flushTask = nullptr;
+  frontFree = nullptr;
+  frameInFlight = false;
+  nextTransition = TRANSITION_NONE;
+  frontTransition = TRANSITION_NONE;
+  frameHeld = false;
+  lastFrameChanged = true;
+  framesPresented = 0;
+  framesSent = 0;
+  lastFlushMicros = 0;
+  graySubframesSent = 0;
+  framesBlocked = 0;
+  memset(frontBuffer, 0, sizeof(frontBuffer)); // Tracks the panel from the first display() on
+  memset(composedBuffer, 0, sizeof(composedBuffer));
+}
+
+MochiDisplay::~MochiDisplay() {
+  buffer = nullptr; // Not ours to free
+}
+
+bool MochiDisplay::begin(uint8_t vccState, uint8_t address) {
+  if (!Adafruit_SSD1306::begin(vccState, address)) return false;
+  if (Panel::flipped) {
+    // Mirror both axes in the controller; the buffer layout is unchanged
+    ssd1306_command(SSD1306_SEGREMAP);
+    ssd1306_command(SSD1306_COMSCANINC);
+  }
+  return true;
+}
+
+bool MochiDisplay::startFlushTask(DisplayFlush* displayFlush, UBaseType_t priority) {
+  if (flushTask != nullptr) return true;
+  if (displayFlush == nullptr) return false;
+
+  flush = displayFlush;
+  frontFree = xSemaphoreCreateBinary();
+  if (frontFree == nullptr) return false;
+  xSemaphoreGive(frontFree);
+
+  // Wire serializes each transaction, so DisplayBrightness and others can
+  // still send commands between our data chunks
+  if (xTaskCreate(flushTaskEntry, "oled_flush", 2048, this, priority, &flushTask) != pdPASS) {
+    flushTask = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void MochiDisplay::display() {
+  uint8_t* back = getBuffer();
+  if (back == nullptr || frameHeld) return;
+
+  if (fade != nullptr) {
+    fade->apply(back); // Before the layers, so only the face is blended
+  }
+
+  const uint8_t* frame = back;
+  if (compositor != nullptr) {
+    compositor->compose(back, composedBuffer);
+    frame = composedBuffer;
+  }
+  if (mirror != nullptr && mirror->hasViewer()) {
+    mirror->capture(frame);
+  }
+
+  TransitionType transition = nextTransition;
+  nextTransition = TRANSITION_NONE;
+
+  if (flushTask == nullptr) {
+    // No task yet (early boot): plain blocking write
+    if (flush != nullptr) {
+      flush->transition(frame, transition);
+    } else {
+      Adafruit_SSD1306::display();
+    }
+    memcpy(frontBuffer, frame, FLUSH_FRAME_BYTES); // What the panel shows once the task starts
+    return;
+  }
+
+  // The front buffer holds the last presented frame (the flush task only reads it)
+  framesPresented++;
+  lastFrameChanged = memcmp(frontBuffer, frame, FLUSH_FRAME_BYTES) != 0;
+  if (!lastFrameChanged) return;
+
+  handOff(frame, transition);
+}
+
+void MochiDisplay::showScreensaver(const uint8_t* scene) {
+  if (scene == nullptr || frameHeld) return;
+  if (mirror != nullptr && mirror->hasViewer()) {
+    mirror->capture(scene);
+  }
+
+  if (flushTask == nullptr) {
+    if (flush != nullptr) {
+      flush->transition(scene, TRANSITION_SCREENSAVER);
+      memcpy(frontBuffer, scene, FLUSH_FRAME_BYTES);
+    }
+    return;
+  }
+  handOff(scene, TRANSITION_SCREENSAVER); // Sent even if unchanged: the scroll has to start
+}
+
+void MochiDisplay::handOff(const uint8_t* frame, TransitionType transition) {
+  if (frameInFlight) framesBlocked++;
+  xSemaphoreTake(frontFree, portMAX_DELAY);
+  memcpy(frontBuffer, frame, FLUSH_FRAME_BYTES);
+  frontTransition = transition;
+  frameInFlight = true;
+  xTaskNotifyGive(flushTask);
+}
+
+void MochiDisplay::flushTaskEntry(void* param) {
+  ((MochiDisplay*)param)->flushLoop();
+}
+
+void MochiDisplay::flushLoop() {
+  bool cycling = false; // Gray subframes are being alternated on the panel
+  for (;;) {
+    TickType_t wait = cycling ? pdMS_TO_TICKS(GRAY_SUBFRAME_MS) : portMAX_DELAY;
+    if (ulTaskNotifyTake(pdTRUE, wait) == 0) {
+      // No new frame in time: next subframe, or back to plain when switched off.
+      // Only pages holding gray pixels differ, so only those are sent.
+      if (grayscaleEnabled) {
+        flush->flushSubframe(grayscale->nextSubframe());
+        graySubframesSent++;
+      } else {
+        flush->flushSubframe(grayscale->getSubframe(GRAY_PLAIN_SUBFRAME));
+        cycling = false;
+      }
+      continue;
+    }
+
+    // The I2C driver sleeps on its interrupt, so loop() runs during the transfer
+    unsigned long start = micros();
+    flush->transition(frontBuffer, frontTransition); // Plain diff flush for TRANSITION_NONE
+    lastFlushMicros = micros() - start;
+    framesSent++;
+
+    // The panel now shows the plain frame, which is the gray plain subframe.
+    // A screensaver is left alone: any write would stop its scroll.
+    cycling = false;
+    if (grayscaleEnabled && frontTransition != TRANSITION_SCREENSAVER) {
+      grayscale->smoothEdges(frontBuffer);
+      cycling = grayscale->hasGray();
+    }
+
+    frameInFlight = false;
+    xSemaphoreGive(frontFree);
+  }
+}
@@ -0,0 +1,136 @@
+/*
+ * Mochi Robot - Double-Buffered Display
+ * SSD1306 with a front buffer streamed out by a background flush task
+ *
+ * Drawing goes to the normal Adafruit buffer (the back buffer). display()
+ * copies it into the front buffer and returns; a FreeRTOS task pushes the
+ * front buffer through DisplayFlush while loop() keeps running. The front
+ * buffer is never touched while a frame is in flight, so frames cannot tear.
+ *
+ * The size is fixed at compile time (Panel, see display_geometry.h) and the
+ * back buffer is a static array, so begin() never allocates it.
+ *
+ * Adafruit_SSD1306 is a private base: its display() and begin() are not
+ * virtual, so through an Adafruit_SSD1306 pointer they would skip the
+ * compositor and write the panel behind the flush task's back. Drawing
+ * code gets the back buffer from canvas() instead, which must only be
+ * drawn into.
+ */
+
+#ifndef MOCHI_DISPLAY_H
+#define MOCHI_DISPLAY_H
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include "display_flush.h"
+#include "display_geometry.h"
+#include "compositor.h"
+#include "grayscale.h"
+
+class FrameMirror;
+class EmotionFade;
+
+class MochiDisplay : private Adafruit_SSD1306 {
+private:
+  alignas(4) static uint8_t backBuffer[Panel::frameBytes]; // Drawn into by the GFX code
+  uint8_t frontBuffer[FLUSH_FRAME_BYTES];
+  uint8_t composedBuffer[FLUSH_FRAME_BYTES]; // Back buffer plus compositor layers
+  DisplayFlush* flush;
+  Compositor* compositor;
+  FrameMirror* mirror;
+  EmotionFade* fade;
+  Grayscale* grayscale;         // Owned by the flush task once set
+  volatile bool grayscaleEnabled;
+  TaskHandle_t flushTask;
+  SemaphoreHandle_t frontFree; // Given when the front buffer may be rewritten
+  volatile bool frameInFlight;
+  TransitionType nextTransition;           // Applied to the next display() call
+  volatile TransitionType frontTransition; // How the flush task shows the front buffer
+  bool frameHeld;
+  bool lastFrameChanged;
+
+  // Statistics
+  unsigned long framesPresented;
+  volatile unsigned long framesSent;
+  volatile unsigned long lastFlushMicros;
+  volatile unsigned long graySubframesSent;
+  unsigned long framesBlocked;
+
+  static void flushTaskEntry(void* param);
+  void flushLoop();
+  void handOff(const uint8_t* frame, TransitionType transition);
+
+public:
+  MochiDisplay(TwoWire* twi, int8_t resetPin);
+  ~MochiDisplay();
+
+  // Adafruit init on the static buffer, plus the 180 degree flip if configured
+  bool begin(uint8_t vccState = SSD1306_SWITCHCAPVCC, uint8_t address = 0x3C);
+
+  // The back buffer as a GFX surface for fonts, widgets and fb_* drawing.
+  // Draw only: never call display() or begin() through it.
+  Adafruit_SSD1306* canvas() { return this; }
+  using Adafruit_SSD1306::clearDisplay;
+  using Adafruit_SSD1306::getBuffer;
+
+  // Start the background flush task; until then display() is synchronous
+  bool startFlushTask(DisplayFlush* displayFlush, UBaseType_t priority = 2);
+
+  // Layers stamped onto every frame in display() (nullptr for none); the
+  // back buffer keeps only what was drawn into it
+  void setCompositor(Compositor* comp) { compositor = comp; }
+
+  // While the mirror has a viewer, every frame handed to display() is also
+  // given to it (nullptr for none)
+  void setMirror(FrameMirror* frameMirror) { mirror = frameMirror; }
+
+  // Emotion cross-fade applied to the back buffer of every frame while
+  // attached (nullptr for none); attach it only around eye rendering
+  void setFade(EmotionFade* emotionFade) { fade = emotionFade; }
+
+  // Grayscale mode (flush task only): each frame is shown with soft edges
+  // by cycling gray subframes between frames. Set the renderer before
+  // startFlushTask(); enabling/disabling is safe at any time.
+  void setGrayscale(Grayscale* gray) { grayscale = gray; }
+  void setGrayscaleEnabled(bool enabled) { grayscaleEnabled = enabled && grayscale != nullptr; }
+  bool isGrayscaleEnabled() { return grayscaleEnabled; }
+
+  // Show the next presented frame through a hardware slide/scroll. The
+  // frame stays in flight for the whole transition.
+  void setNextTransition(TransitionType transition) { nextTransition = transition; }
+
+  // Keep the panel on its current frame: display() drops frames while held
+  // (the boot frame stays up while setup() initializes everything else)
+  void holdFrame(bool hold) { frameHeld = hold; }
+
+  // The frame the last display() call produced (composited if a compositor is set)
+  const uint8_t* getFrame() { return compositor != nullptr ? composedBuffer : getBuffer(); }
+
+  // What the panel shows: the last frame handed to the flush task, or the
+  // screensaver scene (only rewritten by display()/showScreensaver())
+  const uint8_t* getPanelFrame() { return frontBuffer; }
+
+  // Hand the back buffer to the flush task (waits only if the previous
+  // frame is still being sent). Frames identical to the last one are dropped.
+  void display();
+
+  // Put a caller-owned frame on the panel and leave the controller
+  // scrolling it (TRANSITION_SCREENSAVER). Layers, fade and the back buffer
+  // are bypassed and left alone, so display() brings the screen back.
+  void showScreensaver(const uint8_t* scene);
+
+  // True while a frame is being sent; render paths can skip a tick instead of blocking
+  bool isFrameInFlight() { return frameInFlight; }
+
+  // Did the most recent display() call change any pixels?
+  bool getLastFrameChanged() { return lastFrameChanged; }
+
+  // Statistics
+  unsigned long getFramesPresented() { return framesPresented; }
+  unsigned long getFramesSent() { return framesSent; }
+  unsigned long getLastFlushMicros() { return lastFlushMicros; }
+  unsigned long getFramesBlocked() { return framesBlocked; }
+  unsigned long getGraySubframesSent() { return graySubframesSent; }
+};
+
+#endif
@@ -5,23 +5,35 @@
 
 #include "mochi_face.h"
 #include <Arduino.h>
-#include <math.h>
+#include "assets_generated.h"
 
-MochiFace::MochiFace(Adafruit_SSD1306* disp) {
+// Layout rows; 128x32 panels put both stats on the first row
+static constexpr int FACE_NAME_Y = Panel::layout(16, 8);
+static constexpr int FACE_EFFECT_Y = Panel::layout(45, 24);
+static constexpr int FACE_HUNGER_Y = Panel::layout(5, 0);
+static constexpr int FACE_ENERGY_X = Panel::layout(5, 45);
+static constexpr int FACE_ENERGY_Y = Panel::layout(15, 0);
+static constexpr int FACE_WIFI_X = Panel::width - 28;
+
+static_assert(FACE_EFFECT_Y + FONT_CELL_HEIGHT <= Panel::height, "Effect text must fit on the panel");
+
+MochiFace::MochiFace(Adafruit_SSD1306* disp, DisplayFlush* flush, Compositor* comp) : font(disp) {
   display = disp;
+  displayFlush = flush;
+  compositor = comp;
   
   // Emotion state
   currentEmotion = EMO_IDLE;
   emotionStartTime = 0;
   emotionDuration = 0;
-  animationFrame = 0;
+  animationTick = 0;
 }
 
 void MochiFace::setEmotion(Emotion emotion, int duration) {
   currentEmotion = emotion;
   emotionStartTime = millis();
   emotionDuration = duration;
-  animationFrame = 0;
+  animationTick = 0;
 }
 
 const char* MochiFace::getEmotionName(Emotion emotion) {
@@ -51,8 +63,6 @@ const char* MochiFace::getEmotionName(Emotion emotion) {
 }
 
 void MochiFace::update() {
-  animationFrame++;
-  
   // Auto-return to idle after emotion duration
   if (emotionDuration > 0 && (millis() - emotionStartTime) > emotionDuration) {
     if (currentEmotion != EMO_IDLE && currentEmotion != EMO_SLEEPING) {
@@ -61,6 +71,33 @@ void MochiFace::update() {
   }
 }
 
+unsigned long MochiFace::getTimeToNextChange() {
+  unsigned long elapsed = millis() - emotionStartTime;
+  unsigned long wait = ANIM_NO_CHANGE;
+
+  // Steps used by the text effects in draw()
+  switch(currentEmotion) {
+    case EMO_EATING: wait = animTimeToChange({ 500, 2, false }, elapsed); break;   // tick % 20 < 10
+    case EMO_SLEEPING: wait = animTimeToChange({ 500, 4, false }, elapsed); break; // (tick / 10) % 4
+    case EMO_THINKING: wait = animTimeToChange({ 250, 4, false }, elapsed); break; // (tick / 5) % 4
+    case EMO_PET_HAPPY: {
+      // "PURR" is shown for 8 of every 15 ticks
+      unsigned long cycle = elapsed % (15 * ANIM_TICK_MS);
+      unsigned long edge = (cycle < 8 * ANIM_TICK_MS) ? 8 * ANIM_TICK_MS : 15 * ANIM_TICK_MS;
+      wait = edge - cycle;
+      break;
+    }
+    default: break;
+  }
+
+  // Timed emotions fall back to idle
+  if (emotionDuration > 0 && currentEmotion != EMO_IDLE && currentEmotion != EMO_SLEEPING) {
+    unsigned long remaining = (elapsed < (unsigned long)emotionDuration) ? emotionDuration - elapsed : 0;
+    if (remaining < wait) wait = remaining;
+  }
+  return wait;
+}
+
 void MochiFace::draw() {
   draw(-1); // Draw without hunger percentage
 }
@@ -79,26 +116,23 @@ void MochiFace::draw(int hungerPercent, int energyPercent, bool wifiConnected) {
   // Get emotion name
   const char* emotionName = getEmotionName(currentEmotion);
   
-  // Calculate text position (centered)
-  display->setTextSize(2);
   display->setTextColor(SSD1306_WHITE);
   
-  // Get text width for centering (approximate)
-  int textWidth = strlen(emotionName) * 12; // Approximate width per character at size 2
-  int x = max(0, (128 - textWidth) / 2);
-  int y = 15; // Vertical position
+  // Draw main emotion text, centered on page 2
+  font.drawCentered(FACE_NAME_Y, emotionName, 2);
   
-  // Draw main emotion text
-  display->setCursor(x, y);
-  display->print(emotionName);
-  
-  // Draw WiFi icon in top right
-  drawWiFiIcon(wifiConnected);
+  // WiFi icon in top right: the compositor re-renders its status bar
+  // only when the connection changes
+  if (compositor != nullptr) {
+    compositor->setWiFiConnected(wifiConnected);
+  } else {
+    drawWiFiIcon(wifiConnected);
+  }
   
   // Draw hunger percentage if provided
   if (hungerPercent >= 0) {
     display->setTextSize(1);
-    display->setCursor(5, 5);
+    display->setCursor(5, FACE_HUNGER_Y);
     display->print("H:");
     display->print(hungerPercent);
     display->print("%");
@@ -107,21 +141,21 @@ void MochiFace::draw(int hungerPercent, int energyPercent, bool wifiConnected) {
   // Draw energy percentage if provided
   if (energyPercent >= 0) {
     display->setTextSize(1);
-    display->setCursor(5, 15); // Below hunger
+    display->setCursor(FACE_ENERGY_X, FACE_ENERGY_Y); // Below (or beside) hunger
     display->print("E:");
     display->print(energyPercent);
     display->print("%");
   }
   
   // Add animation effects based on emotion
-  animationFrame++;
+  animationTick = (int)animTick(millis() - emotionStartTime);
   
   switch(currentEmotion) {
     case EMO_EATING:
       // Show "NOM NOM" animation
-      if (animationFrame % 20 < 10) {
+      if (animationTick % 20 < 10) {
         display->setTextSize(1);
-        display->setCursor(40, 45);
+        display->setCursor(40, FACE_EFFECT_Y);
         display->print("NOM NOM");
       }
       break;
@@ -129,29 +163,29 @@ void MochiFace::draw(int hungerPercent, int energyPercent, bool wifiConnected) {
     case EMO_HUNGRY:
       // Show "FEED ME" message
       display->setTextSize(1);
-      display->setCursor(35, 45);
+      display->setCursor(35, FACE_EFFECT_Y);
       display->print("FEED ME!");
       break;
       
     case EMO_THROW_UP:
       // Show "BLEH" message
       display->setTextSize(1);
-      display->setCursor(45, 45);
+      display->setCursor(45, FACE_EFFECT_Y);
       display->print("BLEH!");
       break;
       
     case EMO_STARVING:
       // Show critical warning
       display->setTextSize(1);
-      display->setCursor(20, 45);
+      display->setCursor(20, FACE_EFFECT_Y);
       display->print("CRITICAL!");
       break;
       
     case EMO_PET_HAPPY:
       // Show "PURR" message
-      if (animationFrame % 15 < 8) {
+      if (animationTick % 15 < 8) {
         display->setTextSize(1);
-        display->setCursor(45, 45);
+        display->setCursor(45, FACE_EFFECT_Y);
         display->print("PURR");
       }
       break;
@@ -159,29 +193,29 @@ void MochiFace::draw(int hungerPercent, int energyPercent, bool wifiConnected) {
     case EMO_PET_LOVE:
       // Show hearts
       display->setTextSize(1);
-      display->setCursor(50, 45);
+      display->setCursor(50, FACE_EFFECT_Y);
       display->print("<3 <3 <3");
       break;
       
     case EMO_PET_ANNOYED:
       // Show "STOP" message
       display->setTextSize(1);
-      display->setCursor(45, 45);
+      display->setCursor(45, FACE_EFFECT_Y);
       display->print("STOP!");
       break;
       
     case EMO_ANGRY:
       // Show "RAGE" message
       display->setTextSize(1);
-      display->setCursor(45, 45);
+      display->setCursor(45, FACE_EFFECT_Y);
       display->print("RAGE!");
       break;
       
     case EMO_SLEEPING: {
       // Show "Zzz" animation
       display->setTextSize(1);
-      int zCount = (animationFrame / 10) % 4;
-      display->setCursor(50, 45);
+      int zCount = (animationTick / 10) % 4;
+      display->setCursor(50, FACE_EFFECT_Y);
       for (int i = 0; i < zCount; i++) {
         display->print("Z");
       }
@@ -191,8 +225,8 @@ void MochiFace::draw(int hungerPercent, int energyPercent, bool wifiConnected) {
     case EMO_THINKING: {
       // Show "..." animation
       display->setTextSize(1);
-      int dotCount = (animationFrame / 5) % 4;
-      display->setCursor(50, 45);
+      int dotCount = (animationTick / 5) % 4;
+      display->setCursor(50, FACE_EFFECT_Y);
       for (int i = 0; i < dotCount; i++) {
         display->print(".");
       }
@@ -202,86 +236,45 @@ void MochiFace::draw(int hungerPercent, int energyPercent, bool wifiConnected) {
     case EMO_LAUGHING:
       // Show "LOL" message
       display->setTextSize(1);
-      display->setCursor(50, 45);
+      display->setCursor(50, FACE_EFFECT_Y);
       display->print("LOL!");
       break;
       
     case EMO_SURPRISED:
       // Show "WOW" message
       display->setTextSize(1);
-      display->setCursor(50, 45);
+      display->setCursor(50, FACE_EFFECT_Y);
       display->print("WOW!");
       break;
       
     case EMO_CRYING:
       // Show "WAH" message
       display->setTextSize(1);
-      display->setCursor(50, 45);
+      display->setCursor(50, FACE_EFFECT_Y);
       display->print("WAH!");
       break;
       
     case EMO_SICK:
       // Show thermometer
       display->setTextSize(1);
-      display->setCursor(45, 45);
+      display->setCursor(45, FACE_EFFECT_Y);
       display->print("FEVER");
       break;
   }
   
-  display->display();
-}
-
-void MochiFace::drawWiFiIcon(bool connected) {
-  // Draw WiFi icon in top right corner (position: x=100, y=2, size: 12x12)
-  int iconX = 100;
-  int iconY = 2;
-  int iconSize = 12;
+  if (compositor != nullptr) {
+    compositor->compose(display);
+  }
   
-  if (connected) {
-    // Draw WiFi icon (connected) - 3 curved lines
-    // Outer arc
-    for (int i = 0; i < 180; i += 5) {
-      float angle = i * PI / 180.0;
-      int px = iconX + 6 + (iconSize/2 - 1) * cos(angle);
-      int py = iconY + iconSize - 1 - (iconSize/2 - 1) * sin(angle);
-      if (px >= 0 && px < 128 && py >= 0 && py < 64) {
-        display->drawPixel(px, py, SSD1306_WHITE);
-      }
-    }
-    // Middle arc
-    for (int i = 0; i < 180; i += 5) {
-      float angle = i * PI / 180.0;
-      int px = iconX + 6 + (iconSize/2 - 3) * cos(angle);
-      int py = iconY + iconSize - 1 - (iconSize/2 - 3) * sin(angle);
-      if (px >= 0 && px < 128 && py >= 0 && py < 64) {
-        display->drawPixel(px, py, SSD1306_WHITE);
-      }
-    }
-    // Inner dot
-    display->fillCircle(iconX + 6, iconY + iconSize - 1, 1, SSD1306_WHITE);
+  if (displayFlush != nullptr) {
+    displayFlush->flush();
   } else {
-    // Draw WiFi icon with X (not connected/AP mode)
-    // Draw the WiFi arcs first
-    for (int i = 0; i < 180; i += 5) {
-      float angle = i * PI / 180.0;
-      int px = iconX + 6 + (iconSize/2 - 1) * cos(angle);
-      int py = iconY + iconSize - 1 - (iconSize/2 - 1) * sin(angle);
-      if (px >= 0 && px < 128 && py >= 0 && py < 64) {
-        display->drawPixel(px, py, SSD1306_WHITE);
-      }
-    }
-    for (int i = 0; i < 180; i += 5) {
-      float angle = i * PI / 180.0;
-      int px = iconX + 6 + (iconSize/2 - 3) * cos(angle);
-      int py = iconY + iconSize - 1 - (iconSize/2 - 3) * sin(angle);
-      if (px >= 0 && px < 128 && py >= 0 && py < 64) {
-        display->drawPixel(px, py, SSD1306_WHITE);
-      }
-    }
-    display->fillCircle(iconX + 6, iconY + iconSize - 1, 1, SSD1306_WHITE);
-    
-    // Draw X over it (diagonal lines)
-    display->drawLine(iconX + 2, iconY + 2, iconX + iconSize - 2, iconY + iconSize - 2, SSD1306_WHITE);
-    display->drawLine(iconX + iconSize - 2, iconY + 2, iconX + 2, iconY + iconSize - 2, SSD1306_WHITE);
+    display->display();
   }
 }
+
+void MochiFace::drawWiFiIcon(bool connected) {
+  // WiFi icon in top right corner (size: 12x13)
+  // Art lives in assets/wifi_on.pbm and assets/wifi_off.pbm (X = not connected/AP mode)
+  blitAsset(display, connected ? ASSET_WIFI_ON : ASSET_WIFI_OFF, FACE_WIFI_X, 2);
+}
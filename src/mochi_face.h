@@ -8,6 +8,10 @@
 
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "display_flush.h"
+#include "compositor.h"
+#include "fast_font.h"
+#include "anim_clock.h"
 
 // Emotion types
 enum Emotion {
@@ -36,20 +40,23 @@ enum Emotion {
 class MochiFace {
 private:
   Adafruit_SSD1306* display;
+  DisplayFlush* displayFlush;
+  Compositor* compositor; // Cached status bar replaces drawWiFiIcon() when set
+  FastFont font;
   
   // Current emotion
   Emotion currentEmotion;
   unsigned long emotionStartTime;
   int emotionDuration;
   
-  // Animation state
-  int animationFrame;
+  // Animation ticks since the emotion started (time-based, see anim_clock.h)
+  int animationTick;
   
   // Get emotion name as string
   const char* getEmotionName(Emotion emotion);
   
 public:
-  MochiFace(Adafruit_SSD1306* disp);
+  MochiFace(Adafruit_SSD1306* disp, DisplayFlush* flush = nullptr, Compositor* comp = nullptr);
   
   // Main functions
   void draw();
@@ -58,6 +65,9 @@ public:
   void draw(int hungerPercent, int energyPercent, bool wifiConnected); // Draw with WiFi status
   void update();
   
+  // Milliseconds until the text animation or emotion timeout changes the screen
+  unsigned long getTimeToNextChange();
+  
   // WiFi icon drawing
   void drawWiFiIcon(bool connected);
   
@@ -0,0 +1,193 @@
+/*
+ * Mochi Robot - Particle System Implementation
+ */
+
+#include "particle_system.h"
+#include "fb_primitives.h"
+
+ParticleSystem::ParticleSystem(uint16_t capacity) {
+  px = (int16_t*)malloc(capacity * sizeof(int16_t));
+  py = (int16_t*)malloc(capacity * sizeof(int16_t));
+  vx = (int16_t*)malloc(capacity * sizeof(int16_t));
+  vy = (int16_t*)malloc(capacity * sizeof(int16_t));
+  size = (uint8_t*)malloc(capacity);
+  this->capacity = (px && py && vx && vy && size) ? capacity : 0;
+  count = 0;
+  target = 0;
+  memset(&emitter, 0, sizeof(emitter));
+  seed = 0x2545F491;
+  budgetMicros = PARTICLE_BUDGET_MICROS;
+  costNanos = 0;
+  lastFrameMicros = 0;
+  framesRun = 0;
+}
+
+ParticleSystem::~ParticleSystem() {
+  free(px);
+  free(py);
+  free(vx);
+  free(vy);
+  free(size);
+}
+
+// xorshift32: cheap and repeatable, unlike random()
+uint32_t ParticleSystem::nextRandom() {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+// low..high inclusive, multiply-shift instead of a division
+int16_t ParticleSystem::randomRange(int16_t low, int16_t high) {
+  if (high <= low) return low;
+  uint32_t span = (uint32_t)(high - low + 1);
+  return low + (int16_t)(((nextRandom() >> 16) * span) >> 16);
+}
+
+void ParticleSystem::spawn(uint16_t i, bool anywhere) {
+  const int16_t widthQ = Panel::width << PARTICLE_FRAC_BITS;
+  const int16_t heightQ = Panel::height << PARTICLE_FRAC_BITS;
+
+  size[i] = (uint8_t)randomRange(emitter.sizeMin, emitter.sizeMax);
+  vx[i] = randomRange(emitter.vxMin, emitter.vxMax);
+  vy[i] = randomRange(emitter.vyMin, emitter.vyMax);
+  int16_t sizeQ = size[i] << PARTICLE_FRAC_BITS;
+
+  if (emitter.vyMax > 0) {
+    // Falling: enter above the top edge
+    px[i] = randomRange(0, widthQ - 1);
+    py[i] = anywhere ? randomRange(-sizeQ, heightQ - 1) : -sizeQ;
+  } else {
+    // Drifting right: enter past the left edge
+    px[i] = anywhere ? randomRange(-sizeQ, widthQ - 1) : -sizeQ;
+    py[i] = randomRange(0, heightQ - 1);
+  }
+}
+
+void ParticleSystem::setCount(uint16_t wanted) {
+  if (wanted > target) wanted = target;
+  while (count < wanted) {
+    spawn(count++, true);
+  }
+  count = wanted; // Trimming drops the tail of the arrays
+}
+
+void ParticleSystem::setEmitter(const ParticleEmitter& newEmitter) {
+  emitter = newEmitter;
+  if (emitter.sizeMax > PARTICLE_MAX_STREAK && emitter.style == PARTICLE_STREAK) {
+    emitter.sizeMax = PARTICLE_MAX_STREAK;
+  }
+  target = emitter.count < capacity ? emitter.count : capacity;
+  count = 0;
+  costNanos = 0; // Styles cost differently: measure again
+  setCount(target);
+}
+
+void ParticleSystem::step() {
+  const int16_t widthQ = Panel::width << PARTICLE_FRAC_BITS;
+  const int16_t heightQ = Panel::height << PARTICLE_FRAC_BITS;
+
+  if (emitter.sway > 0) {
+    int16_t sway = emitter.sway;
+    for (uint16_t i = 0; i < count; i++) {
+      int16_t v = vx[i] + randomRange(-sway, sway);
+      if (v < emitter.vxMin) v = emitter.vxMin;
+      if (v > emitter.vxMax) v = emitter.vxMax;
+      vx[i] = v;
+    }
+  }
+
+  if (emitter.vyMax > 0) {
+    // Falling: wrap sideways, respawn at the top once below the panel
+    for (uint16_t i = 0; i < count; i++) {
+      int16_t x = px[i] + vx[i];
+      if (x >= widthQ) x -= widthQ;
+      else if (x < 0) x += widthQ;
+      px[i] = x;
+      int16_t y = py[i] + vy[i];
+      py[i] = y;
+      if (y >= heightQ) spawn(i, false);
+    }
+  } else {
+    // Drifting: respawn on the left once past the right edge
+    for (uint16_t i = 0; i < count; i++) {
+      int16_t x = px[i] + vx[i];
+      px[i] = x;
+      if (x >= widthQ) spawn(i, false);
+    }
+  }
+}
+
+void ParticleSystem::render(Adafruit_SSD1306* display) {
+  uint8_t* buffer = display->getBuffer();
+  if (buffer == nullptr) return;
+  int width = display->width();
+  int height = display->height();
+
+  switch (emitter.style) {
+    case PARTICLE_DOT:
+      for (uint16_t i = 0; i < count; i++) {
+        int x = px[i] >> PARTICLE_FRAC_BITS;
+        int y = py[i] >> PARTICLE_FRAC_BITS;
+        if ((unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)height) continue;
+        buffer[x + (y >> 3) * width] |= 1 << (y & 7);
+      }
+      break;
+
+    case PARTICLE_STREAK:
+      // At most PARTICLE_MAX_STREAK rows: one 16-bit column mask over two pages
+      for (uint16_t i = 0; i < count; i++) {
+        int x = px[i] >> PARTICLE_FRAC_BITS;
+        int top = py[i] >> PARTICLE_FRAC_BITS;
+        int bottom = top + size[i] - 1;
+        if ((unsigned)x >= (unsigned)width || bottom < 0 || top >= height) continue;
+        if (top < 0) top = 0;
+        if (bottom >= height) bottom = height - 1;
+        uint16_t bits = (uint16_t)(((1u << (bottom - top + 1)) - 1) << (top & 7));
+        uint8_t* p = buffer + x + (top >> 3) * width;
+        p[0] |= (uint8_t)bits;
+        if (bits >> 8) p[width] |= (uint8_t)(bits >> 8);
+      }
+      break;
+
+    case PARTICLE_PUFF:
+      for (uint16_t i = 0; i < count; i++) {
+        int x = px[i] >> PARTICLE_FRAC_BITS;
+        int y = py[i] >> PARTICLE_FRAC_BITS;
+        fbDrawHLine(display, x, y, size[i], SSD1306_WHITE);
+        fbDrawHLine(display, x + size[i] / 4, y - 1, size[i] / 2, SSD1306_WHITE);
+      }
+      break;
+
+    case PARTICLE_BAND:
+      for (uint16_t i = 0; i < count; i++) {
+        fbDrawHLine(display, px[i] >> PARTICLE_FRAC_BITS, py[i] >> PARTICLE_FRAC_BITS, size[i], SSD1306_WHITE);
+      }
+      break;
+  }
+}
+
+void ParticleSystem::frame(Adafruit_SSD1306* display) {
+  unsigned long start = micros();
+  step();
+  render(display);
+  lastFrameMicros = micros() - start;
+  framesRun++;
+
+  // Cost is linear in the count: average it per particle
+  if (count > 0) {
+    uint32_t sample = lastFrameMicros * 1000 / count;
+    costNanos = (costNanos == 0) ? sample : (costNanos * 3 + sample) / 4;
+  }
+
+  uint32_t wanted = target;
+  if (costNanos > 0) {
+    uint32_t fit = budgetMicros * 1000 / costNanos;
+    if (fit < wanted) wanted = fit;
+  }
+  if (wanted < PARTICLE_MIN_COUNT) wanted = PARTICLE_MIN_COUNT;
+  // Shrink at once, grow a few per frame so timing noise does not make particles flicker
+  if (wanted > (uint32_t)count + PARTICLE_MIN_COUNT) wanted = count + PARTICLE_MIN_COUNT;
+  setCount((uint16_t)wanted);
+}
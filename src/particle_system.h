@@ -0,0 +1,113 @@
+/*
+ * Mochi Robot - Particle System
+ * Fixed-capacity weather particles (rain, snow, cloud drift) in fixed point
+ *
+ * Particles are a structure of arrays: positions and velocities are Q6
+ * (1/64 px) int16 arrays, plus one size byte each, allocated once for the
+ * capacity. step() moves every live particle with two adds and respawns the
+ * ones that left the panel; render() ORs them into a 1bpp page buffer.
+ * Streaks and dots are one or two masked page bytes, puffs and fog bands
+ * are fb_primitives spans, so a frame costs the same per particle whatever
+ * the scene and the total grows linearly with the count.
+ *
+ * frame() times step() + render() and keeps a moving average of the cost
+ * per particle; the live count is trimmed so a frame fits the CPU budget
+ * (setBudgetMicros()) and grows back to the emitter's count when it can.
+ */
+
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include "display_geometry.h"
+
+#define PARTICLE_FRAC_BITS 6         // Q6 positions and velocities
+#define PARTICLE_ONE (1 << PARTICLE_FRAC_BITS)
+#define PARTICLE_FRAME_MS 50         // Velocities are per frame of this length
+#define PARTICLE_BUDGET_MICROS 2000  // Default CPU budget per frame
+#define PARTICLE_MIN_COUNT 8         // Never trimmed below this (keeps the cost measurable)
+#define PARTICLE_MAX_STREAK 8        // Streaks span at most two pages
+
+static_assert(((Panel::width + 64) << PARTICLE_FRAC_BITS) <= INT16_MAX, "Q6 positions must fit int16");
+
+enum ParticleStyle : uint8_t {
+  PARTICLE_DOT = 0, // One pixel (snow)
+  PARTICLE_STREAK,  // Vertical line of `size` pixels (rain)
+  PARTICLE_PUFF,    // `size` wide span with a half-width cap above (cloud)
+  PARTICLE_BAND     // `size` wide span (mist)
+};
+
+// What a scene spawns; velocities are Q6 px per PARTICLE_FRAME_MS
+struct ParticleEmitter {
+  ParticleStyle style;
+  uint16_t count;         // Particles wanted (0 = no animation)
+  int16_t vxMin, vxMax;
+  int16_t vyMin, vyMax;   // vyMax == 0: drifts sideways, respawns on the left
+  uint8_t sizeMin, sizeMax;
+  uint8_t sway;           // Random walk of vx per frame (snow)
+};
+
+class ParticleSystem {
+private:
+  // Structure of arrays, `capacity` entries each
+  int16_t* px;
+  int16_t* py;
+  int16_t* vx;
+  int16_t* vy;
+  uint8_t* size;
+  uint16_t capacity;
+  uint16_t count;   // Live particles
+  uint16_t target;  // Emitter count clamped to the capacity
+
+  ParticleEmitter emitter;
+  uint32_t seed;
+
+  // Budget
+  unsigned long budgetMicros;
+  uint32_t costNanos; // Per particle, moving average (0 = not measured yet)
+  unsigned long lastFrameMicros;
+  unsigned long framesRun;
+
+  uint32_t nextRandom();
+  int16_t randomRange(int16_t low, int16_t high);
+  void spawn(uint16_t i, bool anywhere);
+  void setCount(uint16_t wanted);
+
+public:
+  ParticleSystem(uint16_t capacity);
+  ~ParticleSystem();
+
+  // Start a scene: particles scattered over the whole panel
+  void setEmitter(const ParticleEmitter& newEmitter);
+  const ParticleEmitter& getEmitter() { return emitter; }
+  bool isAnimated() { return target > 0; }
+
+  // Same scatter and motion for the same seed (tests)
+  void setSeed(uint32_t value) { seed = value ? value : 1; }
+
+  void setBudgetMicros(unsigned long micros) { budgetMicros = micros; }
+  unsigned long getBudgetMicros() { return budgetMicros; }
+
+  // One simulation step / OR the particles into the buffer (no clearing)
+  void step();
+  void render(Adafruit_SSD1306* display);
+
+  // step() + render(), timed; then fit the live count to the budget
+  void frame(Adafruit_SSD1306* display);
+
+  // Statistics
+  uint16_t getCapacity() { return capacity; }
+  uint16_t getCount() { return count; }
+  uint16_t getTargetCount() { return target; }
+  uint32_t getCostNanos() { return costNanos; }
+  unsigned long getLastFrameMicros() { return lastFrameMicros; }
+  unsigned long getFramesRun() { return framesRun; }
+
+  // Read-only views of the arrays (tests)
+  const int16_t* getX() { return px; }
+  const int16_t* getY() { return py; }
+  const uint8_t* getSizes() { return size; }
+};
+
+#endif
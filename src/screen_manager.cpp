@@ -5,77 +5,366 @@
 #include "screen_manager.h"
 #include <Arduino.h>
 #include <time.h>
+#include <sys/time.h>
 
-ScreenManager::ScreenManager(Adafruit_SSD1306* disp) {
+// Widget layout for 128x64, with the compact (128x32) value second. Compact
+// panels drop the prayer header and the Bluetooth row (the status bar
+// covers those) and show the settings page number at the end of the last row.
+static constexpr int CLOCK_TIME_Y = Panel::layout(24, 8);
+static constexpr int CLOCK_DATE_Y = Panel::layout(40, 24);
+static constexpr int CLOCK_HINT_Y = Panel::layout(28, 8);
+static constexpr int CLOCK_HINT2_Y = Panel::layout(40, 20);
+static constexpr int PRAYER_NAME_Y = Panel::layout(16, 8);
+static constexpr int PRAYER_TIME_Y = Panel::layout(38, 24);
+static constexpr int PRAYER_COUNTDOWN_Y = Panel::layout(48, 0); // Takes the header's row when compact
+static constexpr int HINT_Y = Panel::layout(30, 8);
+static constexpr int HINT2_Y = Panel::layout(40, 18);
+static constexpr int WEATHER_LABEL_Y = Panel::layout(5, 0);
+static constexpr int WEATHER_TEMP_X = 10;
+static constexpr int WEATHER_TEMP_Y = Panel::layout(16, 8);
+static constexpr int WEATHER_TEMP_SCALE = Panel::layout(3, 2);
+static constexpr int WEATHER_TEMP_CHARS = 4; // "23.5"; longer values drop the decimal
+static constexpr int WEATHER_TEMP_WIDTH = fontTextWidth(WEATHER_TEMP_CHARS, WEATHER_TEMP_SCALE) +
+                                          fontTextWidth(1, WEATHER_TEMP_SCALE - 1); // "C" one size down
+static constexpr int WEATHER_NAME_Y = Panel::layout(48, 24);
+static constexpr int WEATHER_ICON_SIZE = Panel::layout(32, 16);
+static constexpr int WEATHER_ICON_X = Panel::width - WEATHER_ICON_SIZE;
+static constexpr int WEATHER_ICON_Y = Panel::layout(16, 8); // Page-aligned so the icon blits as whole bytes
+static constexpr int SETTINGS_ROWS = Panel::layout(5, 4);
+static constexpr int SETTINGS_LAST_ROW_CHARS = Panel::layout(20, 17); // Leaves room for the page number
+static constexpr int SETTINGS_PAGE_CHARS = Panel::layout(8, 3); // "Page 1/4", or "1/4" when compact
+static constexpr int SETTINGS_PAGE_X = Panel::layout(5, Panel::width - fontTextWidth(3, 1));
+static constexpr int SETTINGS_PAGE_Y = Panel::layout(55, 24);
+
+static constexpr int settingsRowY(int row) {
+  return Panel::layout(5 + row * 10, row * 8);
+}
+
+static constexpr int settingsRowChars(int row) {
+  return row == SETTINGS_ROWS - 1 ? SETTINGS_LAST_ROW_CHARS : 20;
+}
+
+static_assert(fontTextWidth(8, 2) <= Panel::width, "Clock must fit the panel width");
+static_assert(CLOCK_DATE_Y + FONT_CELL_HEIGHT <= Panel::height, "Date must fit the panel");
+static_assert(WEATHER_NAME_Y + FONT_CELL_HEIGHT <= Panel::height, "Weather text must fit the panel");
+static_assert(WEATHER_ICON_Y % 8 == 0 && WEATHER_ICON_Y + WEATHER_ICON_SIZE <= Panel::height,
+              "Weather icon must be page-aligned and on the panel");
+static_assert(WEATHER_TEMP_X + WEATHER_TEMP_WIDTH <= WEATHER_ICON_X,
+              "Temperature must not run into the weather icon");
+static_assert(settingsRowY(SETTINGS_ROWS - 1) + FONT_CELL_HEIGHT <= Panel::height, "Settings rows must fit");
+static_assert(SETTINGS_PAGE_Y + FONT_CELL_HEIGHT <= Panel::height, "Page number must fit");
+static_assert(settingsRowY(SETTINGS_ROWS - 1) + FONT_CELL_HEIGHT <= SETTINGS_PAGE_Y ||
+              5 + fontTextWidth(settingsRowChars(SETTINGS_ROWS - 1), 1) <= SETTINGS_PAGE_X,
+              "Page number must not overlap the settings rows");
+
+ScreenManager::ScreenManager(MochiDisplay* disp, Compositor* comp)
+  : font(disp->canvas()),
+    weatherParticles(WEATHER_PARTICLE_CAPACITY),
+    clockTime(fontCenterX(8, 2), CLOCK_TIME_Y, 8, 2),
+    clockDate(fontCenterX(10, 1), CLOCK_DATE_Y, 10),
+    clockHint(20, CLOCK_HINT_Y, 12),
+    clockHint2(15, CLOCK_HINT2_Y, 12),
+    prayerHeader(10, 5, 18),
+    prayerName(10, PRAYER_NAME_Y, 9, 2),
+    prayerTime(10, PRAYER_TIME_Y, 18),
+    prayerCountdown(10, PRAYER_COUNTDOWN_Y, 18),
+    prayerHint(10, HINT_Y, 18),
+    prayerHint2(10, HINT2_Y, 18),
+    weatherCachedLabel(5, WEATHER_LABEL_Y, 8),
+    weatherTemp(WEATHER_TEMP_X, WEATHER_TEMP_Y, WEATHER_TEMP_CHARS, WEATHER_TEMP_SCALE, 1, "C"),
+    weatherName(10, WEATHER_NAME_Y, 14),
+    weatherIcon(WEATHER_ICON_X, WEATHER_ICON_Y, WEATHER_ICON_SIZE, WEATHER_ICON_SIZE),
+    weatherHint(10, HINT_Y, 18),
+    weatherHint2(10, HINT2_Y, 18),
+    settingsRows{Label(5, settingsRowY(0), settingsRowChars(0)), Label(5, settingsRowY(1), settingsRowChars(1)),
+                 Label(5, settingsRowY(2), settingsRowChars(2)), Label(5, settingsRowY(3), settingsRowChars(3)),
+                 Label(5, settingsRowY(4), settingsRowChars(4))},
+    settingsPageLabel(SETTINGS_PAGE_X, SETTINGS_PAGE_Y, SETTINGS_PAGE_CHARS),
+    prerenderNext(Panel::width, Panel::height),
+    prerenderSettings(Panel::width, Panel::height) {
   display = disp;
+  compositor = comp;
   currentScreen = SCREEN_ROBOT_EYES;
   lastScreenUpdate = 0;
-  screenUpdateInterval = 100; // Update every 100ms
+  screenUpdateInterval = 100; // Check for invalidation every 100ms
+  dirtyScreens = 0xFF;        // Everything needs a first draw
+  lastClockSecond = 0;
+  lastUptimeMinute = 0;
+  nextTimeTrigger = 0;
+  hasTimeTrigger = false;
   timeSynced = false;
   settingsPage = 0;
   temperature = 0.0;
+  weatherCondition = WEATHER_UNKNOWN;
   weatherCached = false;
+  lastParticleFrame = 0;
   minutesUntilPrayer = 0;
   wifiRSSI = 0;
   bluetoothEnabled = false;
+  panelCurrentTenths = 0;
+  drawnScreen = SCREEN_COUNT;
+  lastWidgetsDrawn = 0;
+  prerenderNextScreen = SCREEN_COUNT;
+  prerenderValid = 0;
+  switchStartMicros = 0;
+  switchLatencyMicros = 0;
+  switchPending = false;
+  lastSwitchPrerendered = false;
+  prerenderHits = 0;
+  prerenderMisses = 0;
+  
+  // Fixed texts are bound once
+  clockHint.setText("No Time Sync");
+  clockHint2.setText("Connect WiFi");
+  prayerHeader.setText("Next Prayer:");
+  prayerHint.setText("No prayer data");
+  prayerHint2.setText("Connect WiFi");
+  weatherCachedLabel.setText("(Cached)");
+  weatherHint.setText("No weather data");
+  weatherHint2.setText("Connect WiFi");
+  
+  screens[SCREEN_CLOCK].add(&clockTime);
+  screens[SCREEN_CLOCK].add(&clockDate);
+  screens[SCREEN_CLOCK].add(&clockHint);
+  screens[SCREEN_CLOCK].add(&clockHint2);
+  
+  if (!Panel::compact) {
+    screens[SCREEN_PRAYER_TIME].add(&prayerHeader);
+  }
+  screens[SCREEN_PRAYER_TIME].add(&prayerName);
+  screens[SCREEN_PRAYER_TIME].add(&prayerTime);
+  screens[SCREEN_PRAYER_TIME].add(&prayerCountdown);
+  screens[SCREEN_PRAYER_TIME].add(&prayerHint);
+  screens[SCREEN_PRAYER_TIME].add(&prayerHint2);
+  
+  screens[SCREEN_WEATHER].add(&weatherCachedLabel);
+  screens[SCREEN_WEATHER].add(&weatherTemp);
+  screens[SCREEN_WEATHER].add(&weatherName);
+  screens[SCREEN_WEATHER].add(&weatherIcon);
+  screens[SCREEN_WEATHER].add(&weatherHint);
+  screens[SCREEN_WEATHER].add(&weatherHint2);
+  
+  for (int i = 0; i < SETTINGS_ROWS; i++) {
+    screens[SCREEN_SETTINGS].add(&settingsRows[i]);
+  }
+  screens[SCREEN_SETTINGS].add(&settingsPageLabel);
+  
+  if (compositor != nullptr) {
+    compositor->setStatusVisible(currentScreen != SCREEN_ROBOT_EYES);
+  }
 }
 
 void ScreenManager::nextScreen() {
   // Cycle through screens: Robot Eyes -> Clock -> Prayer -> Weather -> Settings -> Robot Eyes
-  currentScreen = (ScreenType)((currentScreen + 1) % SCREEN_COUNT);
-  lastScreenUpdate = 0; // Force immediate update
+  setScreen((ScreenType)((currentScreen + 1) % SCREEN_COUNT), TRANSITION_SLIDE_UP);
 }
 
-void ScreenManager::setScreen(ScreenType screen) {
+void ScreenManager::setScreen(ScreenType screen, TransitionType transition) {
   if (screen < SCREEN_COUNT) {
+    bool entering = (screen != currentScreen);
     currentScreen = screen;
-    lastScreenUpdate = 0;
+    display->setNextTransition(transition); // Whoever renders the screen next presents through it
+    if (compositor != nullptr) {
+      // The eyes use the whole panel; info screens share the status bar
+      compositor->setStatusVisible(screen != SCREEN_ROBOT_EYES);
+      compositor->setBackgroundEnabled(weatherAnimated());
+    }
+    if (entering && weatherAnimated()) {
+      updateWeatherLayer(); // Particles are there with the first frame
+    }
+    lastScreenUpdate = 0; // Force immediate update
+    
+    switchStartMicros = micros();
+    switchPending = (screen != SCREEN_ROBOT_EYES);
+    lastSwitchPrerendered = isPrerendered(screen);
+    
+    if (lastSwitchPrerendered) {
+      // The widgets already match the spare frame: adopt it and let draw()
+      // re-rasterize only what changed since it was rendered
+      Layer* slot = (screen == SCREEN_SETTINGS) ? &prerenderSettings : &prerenderNext;
+      memcpy(display->getBuffer(), slot->getBuffer(), Panel::frameBytes);
+      prerenderValid &= ~(1 << screen); // Its widgets now follow the live buffer
+      drawnScreen = screen;
+      prerenderHits++;
+      draw();
+      dirtyScreens &= ~(1 << screen);
+    } else {
+      invalidate(screen);   // Buffer holds the previous screen
+      drawnScreen = SCREEN_COUNT;
+      if (switchPending) prerenderMisses++;
+    }
+  }
+}
+
+bool ScreenManager::prerenderIdle() {
+  // Candidates: the next screen in the cycle, then Settings (long press)
+  ScreenType next = (ScreenType)((currentScreen + 1) % SCREEN_COUNT);
+  ScreenType target = SCREEN_COUNT;
+  if (next != SCREEN_ROBOT_EYES && next != SCREEN_SETTINGS && !isPrerendered(next)) {
+    target = next;
+  } else if (currentScreen != SCREEN_SETTINGS && !isPrerendered(SCREEN_SETTINGS)) {
+    target = SCREEN_SETTINGS;
+  }
+  if (target == SCREEN_COUNT) {
+    return false;
+  }
+  
+  Layer* slot = (target == SCREEN_SETTINGS) ? &prerenderSettings : &prerenderNext;
+  if (!slot->isValid()) {
+    return false; // No memory for the spare frame: switches render as before
+  }
+  if (target != SCREEN_SETTINGS) {
+    if (prerenderNextScreen < SCREEN_COUNT) {
+      prerenderValid &= ~(1 << prerenderNextScreen); // Slot is being reused
+    }
+    prerenderNextScreen = target;
   }
+  
+  bindScreen(target);
+  slot->clearDisplay();
+  font.setDisplay(slot);
+  screens[target].draw(slot, &font, true);
+  font.setDisplay(display->canvas());
+  prerenderValid |= (1 << target);
+  return true;
 }
 
 void ScreenManager::update() {
   unsigned long now = millis();
-  if (now - lastScreenUpdate >= screenUpdateInterval) {
-    lastScreenUpdate = now;
+  // Clock ticks run on their own deadline, data changes on the poll interval
+  bool triggerDue = hasTimeTrigger && (long)(now - nextTimeTrigger) >= 0;
+  if (!triggerDue && now - lastScreenUpdate < screenUpdateInterval) {
+    return;
+  }
+  lastScreenUpdate = now;
+  
+  checkTimeTriggers();
+  unsigned long wait = getTimeToNextChange();
+  hasTimeTrigger = (wait != ANIM_NO_CHANGE);
+  nextTimeTrigger = now + wait;
+  
+  // Only render when the visible screen's data (or the status bar) changed;
+  // if the previous frame is still on the bus, keep the dirty bit and try next tick
+  bool statusChanged = compositor != nullptr && compositor->needsCompose();
+  if ((isDirty(currentScreen) || statusChanged) && !display->isFrameInFlight()) {
+    dirtyScreens &= ~(1 << currentScreen);
     draw();
   }
 }
 
+void ScreenManager::checkTimeTriggers() {
+  // Clock: second boundary
+  if (currentScreen == SCREEN_CLOCK && timeSynced) {
+    time_t now;
+    time(&now);
+    if (now != lastClockSecond) {
+      lastClockSecond = now;
+      invalidate(SCREEN_CLOCK);
+    }
+  }
+  
+  // Settings System Info: uptime/heap refresh on minute boundary
+  if (currentScreen == SCREEN_SETTINGS && settingsPage == 3) {
+    unsigned long minute = millis() / 60000;
+    if (minute != lastUptimeMinute) {
+      lastUptimeMinute = minute;
+      invalidate(SCREEN_SETTINGS);
+    }
+  }
+  
+  // Weather: next particle frame
+  if (weatherAnimated() && millis() - lastParticleFrame >= PARTICLE_FRAME_MS) {
+    updateWeatherLayer();
+  }
+}
+
+bool ScreenManager::weatherAnimated() {
+  return compositor != nullptr && compositor->hasBackground() &&
+         currentScreen == SCREEN_WEATHER && weatherParticles.isAnimated();
+}
+
+void ScreenManager::updateWeatherLayer() {
+  // Particles live in the compositor background, ORed under the widgets,
+  // so the retained widgets are never redrawn for them
+  Adafruit_SSD1306* layer = compositor->getBackground();
+  layer->clearDisplay();
+  weatherParticles.frame(layer);
+  compositor->markBackground();
+  lastParticleFrame = millis();
+}
+
+unsigned long ScreenManager::getTimeToNextChange() {
+  if (currentScreen == SCREEN_CLOCK && timeSynced) {
+    // Next wall-clock second
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return 1000 - tv.tv_usec / 1000;
+  }
+  if (currentScreen == SCREEN_SETTINGS && settingsPage == 3) {
+    return 60000 - millis() % 60000; // Uptime minute
+  }
+  if (weatherAnimated()) {
+    unsigned long elapsed = millis() - lastParticleFrame;
+    return elapsed >= PARTICLE_FRAME_MS ? 0 : PARTICLE_FRAME_MS - elapsed;
+  }
+  return ANIM_NO_CHANGE;
+}
+
 void ScreenManager::draw() {
-  // Robot eyes screen is handled by RoboEyes library in main loop
+  // Robot eyes screen is handled by EyeEngine in main loop
   if (currentScreen == SCREEN_ROBOT_EYES) {
-    return; // Don't draw anything, RoboEyes handles it
+    return; // Don't draw anything, EyeEngine handles it
   }
   
-  display->clearDisplay();
+  bindScreen(currentScreen);
   
-  switch(currentScreen) {
+  // After a screen switch the buffer holds another screen: start clean.
+  // Otherwise only widgets whose values changed are re-rasterized.
+  bool full = (drawnScreen != currentScreen);
+  if (full) {
+    display->clearDisplay();
+  }
+  lastWidgetsDrawn = screens[currentScreen].draw(display->canvas(), &font, full);
+  drawnScreen = currentScreen;
+  
+  bool statusChanged = compositor != nullptr && compositor->needsCompose();
+  if (lastWidgetsDrawn > 0 || statusChanged || switchPending) {
+    display->display(); // Composited, then queued for the flush task
+  }
+  if (switchPending) {
+    switchLatencyMicros = micros() - switchStartMicros;
+    switchPending = false;
+  }
+}
+
+void ScreenManager::bindScreen(ScreenType screen) {
+  switch(screen) {
     case SCREEN_CLOCK:
-      drawClock();
+      bindClock();
       break;
       
     case SCREEN_PRAYER_TIME:
-      drawPrayerTime();
+      bindPrayerTime();
       break;
       
     case SCREEN_WEATHER:
-      drawWeather();
+      bindWeather();
       break;
       
     case SCREEN_SETTINGS:
-      drawSettings();
+      bindSettings();
       break;
       
     default:
       break;
   }
-  
-  display->display();
 }
 
-void ScreenManager::drawClock() {
-  display->setTextSize(2);
-  display->setTextColor(SSD1306_WHITE);
+void ScreenManager::bindClock() {
+  clockTime.setVisible(timeSynced);
+  clockDate.setVisible(timeSynced);
+  clockHint.setVisible(!timeSynced);
+  clockHint2.setVisible(!timeSynced);
   
   if (timeSynced) {
     // Update time info
@@ -85,235 +374,214 @@ void ScreenManager::drawClock() {
     
     char timeStr[9];
     strftime(timeStr, sizeof(timeStr), "%H:%M:%S", &timeInfo);
+    clockTime.setText(timeStr);
     
-    // Center the time
-    int16_t x1, y1;
-    uint16_t w, h;
-    display->getTextBounds(timeStr, 0, 0, &x1, &y1, &w, &h);
-    int x = (128 - w) / 2;
-    int y = (64 - h) / 2;
-    
-    display->setCursor(x, y);
-    display->print(timeStr);
-    
-    // Show date below
-    display->setTextSize(1);
     char dateStr[12];
     strftime(dateStr, sizeof(dateStr), "%d/%m/%Y", &timeInfo);
-    display->getTextBounds(dateStr, 0, 0, &x1, &y1, &w, &h);
-    x = (128 - w) / 2;
-    display->setCursor(x, y + h + 5);
-    display->print(dateStr);
-  } else {
-    // Show "No Time Sync"
-    display->setTextSize(1);
-    display->setCursor(20, 28);
-    display->print("No Time Sync");
-    display->setCursor(15, 40);
-    display->print("Connect WiFi");
+    clockDate.setText(dateStr);
   }
 }
 
-void ScreenManager::drawPrayerTime() {
-  display->setTextSize(1);
-  display->setTextColor(SSD1306_WHITE);
-  
-  display->setCursor(10, 5);
-  display->print("Next Prayer:");
+void ScreenManager::bindPrayerTime() {
+  bool hasData = nextPrayerName.length() > 0;
+  prayerName.setVisible(hasData);
+  prayerTime.setVisible(hasData);
+  prayerCountdown.setVisible(hasData && minutesUntilPrayer > 0);
+  prayerHint.setVisible(!hasData);
+  prayerHint2.setVisible(!hasData);
   
-  if (nextPrayerName.length() > 0) {
-    display->setTextSize(2);
-    display->setCursor(10, 18);
-    display->print(nextPrayerName);
-    
-    display->setTextSize(1);
-    display->setCursor(10, 38);
-    display->print("Time: ");
-    display->print(nextPrayerTime);
-    
-    if (minutesUntilPrayer > 0) {
-      display->setCursor(10, 48);
-      display->print("In: ");
-      display->print(minutesUntilPrayer);
-      display->print(" min");
-    }
-  } else {
-    display->setTextSize(1);
-    display->setCursor(10, 30);
-    display->print("No prayer data");
-    display->setCursor(10, 40);
-    display->print("Connect WiFi");
+  if (hasData) {
+    char line[WIDGET_TEXT_MAX];
+    prayerName.setText(nextPrayerName.c_str());
+    snprintf(line, sizeof(line), "Time: %s", nextPrayerTime.c_str());
+    prayerTime.setText(line);
+    snprintf(line, sizeof(line), "In: %d min", minutesUntilPrayer);
+    prayerCountdown.setText(line);
   }
 }
 
-void ScreenManager::drawWeather() {
-  display->setTextSize(1);
-  display->setTextColor(SSD1306_WHITE);
+void ScreenManager::bindWeather() {
+  bool hasData = temperature != 0.0 || weatherCondition != WEATHER_UNKNOWN;
+  weatherCachedLabel.setVisible(weatherCached);
+  weatherTemp.setVisible(hasData);
+  weatherName.setVisible(hasData);
+  weatherIcon.setVisible(hasData);
+  weatherHint.setVisible(!hasData);
+  weatherHint2.setVisible(!hasData);
   
-  if (weatherCached) {
-    display->setCursor(5, 5);
-    display->print("(Cached)");
-  }
-  
-  if (temperature != 0.0 || weatherCondition.length() > 0) {
-    display->setTextSize(3);
-    display->setCursor(10, 20);
-    display->print(temperature, 1);
-    display->setTextSize(2);
-    display->print("C");
-    
-    display->setTextSize(1);
-    display->setCursor(10, 50);
-    display->print(weatherCondition);
-    
-    if (weatherIcon.length() > 0) {
-      display->setCursor(100, 25);
-      display->setTextSize(2);
-      display->print(weatherIcon);
-    }
-  } else {
-    display->setTextSize(1);
-    display->setCursor(10, 30);
-    display->print("No weather data");
-    display->setCursor(10, 40);
-    display->print("Connect WiFi");
+  if (hasData) {
+    weatherTemp.setValue(temperature);
+    weatherName.setText(weatherConditionName(weatherCondition));
+    weatherIcon.setAsset(&weatherConditionIcon(weatherCondition, !Panel::compact));
   }
 }
 
-void ScreenManager::drawSettings() {
-  display->setTextSize(1);
-  display->setTextColor(SSD1306_WHITE);
+void ScreenManager::bindSettings() {
+  char rows[5][SETTINGS_ROW_MAX];
+  for (int i = 0; i < 5; i++) rows[i][0] = '\0';
   
   // Settings page 0: WiFi Status
   if (settingsPage == 0) {
-    display->setCursor(5, 5);
-    display->print("WiFi Status");
-    display->setCursor(5, 15);
-    if (wifiSSID.length() > 0) {
-      display->print("SSID: ");
-      String ssid = wifiSSID;
-      if (ssid.length() > 15) ssid = ssid.substring(0, 12) + "...";
-      display->print(ssid);
-    } else {
-      display->print("SSID: Not connected");
-    }
-    display->setCursor(5, 25);
-    if (wifiIP.length() > 0) {
-      display->print("IP: ");
-      display->print(wifiIP);
-    } else {
-      display->print("IP: N/A");
-    }
-    display->setCursor(5, 35);
+    strcpy(rows[0], "WiFi Status");
+    // Long SSIDs are cut with "..." by the label
+    snprintf(rows[1], sizeof(rows[0]), "SSID: %s",
+             wifiSSID.length() > 0 ? wifiSSID.c_str() : "Not connected");
+    snprintf(rows[2], sizeof(rows[0]), "IP: %s",
+             wifiIP.length() > 0 ? wifiIP.c_str() : "N/A");
     if (wifiRSSI != 0) {
-      display->print("Signal: ");
-      display->print(wifiRSSI);
-      display->print(" dBm");
+      snprintf(rows[3], sizeof(rows[0]), "Signal: %d dBm", wifiRSSI);
     } else {
-      display->print("Signal: N/A");
+      strcpy(rows[3], "Signal: N/A");
     }
-    display->setCursor(5, 45);
-    display->print("BT: ");
-    display->print(bluetoothEnabled ? "ON" : "OFF");
+    snprintf(rows[4], sizeof(rows[0]), "BT: %s", bluetoothEnabled ? "ON" : "OFF");
   }
   // Settings page 1: API Updates
   else if (settingsPage == 1) {
-    display->setCursor(5, 5);
-    display->print("Last Updates");
-    display->setCursor(5, 15);
-    display->print("Weather: ");
-    if (lastWeatherUpdate.length() > 0) {
-      display->print(lastWeatherUpdate);
-    } else {
-      display->print("Never");
-    }
-    display->setCursor(5, 25);
-    display->print("Prayer: ");
-    if (lastPrayerUpdate.length() > 0) {
-      display->print(lastPrayerUpdate);
-    } else {
-      display->print("Never");
-    }
-    display->setCursor(5, 35);
-    display->print("NTP: ");
-    if (lastNTPUpdate.length() > 0) {
-      display->print(lastNTPUpdate);
-    } else {
-      display->print("Never");
-    }
+    strcpy(rows[0], "Last Updates");
+    snprintf(rows[1], sizeof(rows[0]), "Weather: %s",
+             lastWeatherUpdate.length() > 0 ? lastWeatherUpdate.c_str() : "Never");
+    snprintf(rows[2], sizeof(rows[0]), "Prayer: %s",
+             lastPrayerUpdate.length() > 0 ? lastPrayerUpdate.c_str() : "Never");
+    snprintf(rows[3], sizeof(rows[0]), "NTP: %s",
+             lastNTPUpdate.length() > 0 ? lastNTPUpdate.c_str() : "Never");
   }
   // Settings page 2: Location
   else if (settingsPage == 2) {
-    display->setCursor(5, 5);
-    display->print("Location");
-    display->setCursor(5, 15);
-    display->print("Monastir, Tunisia");
-    display->setCursor(5, 25);
-    display->print("Lat: 35.7784");
-    display->setCursor(5, 35);
-    display->print("Lon: 10.8262");
+    strcpy(rows[0], "Location");
+    strcpy(rows[1], "Monastir, Tunisia");
+    strcpy(rows[2], "Lat: 35.7784");
+    strcpy(rows[3], "Lon: 10.8262");
   }
   // Settings page 3: System Info
   else if (settingsPage == 3) {
-    display->setCursor(5, 5);
-    display->print("System Info");
-    display->setCursor(5, 15);
-    display->print("Firmware: 1.0");
+    strcpy(rows[0], "System Info");
+    strcpy(rows[1], "Firmware: 1.0");
     
-    // Uptime
     unsigned long uptime = millis() / 1000;
     unsigned long hours = uptime / 3600;
     unsigned long minutes = (uptime % 3600) / 60;
-    display->setCursor(5, 25);
-    display->print("Uptime: ");
     if (hours > 0) {
-      display->print(hours);
-      display->print("h ");
+      snprintf(rows[2], sizeof(rows[0]), "Uptime: %luh %lum", hours, minutes);
+    } else {
+      snprintf(rows[2], sizeof(rows[0]), "Uptime: %lum", minutes);
     }
-    display->print(minutes);
-    display->print("m");
-    
-    // Free heap
-    display->setCursor(5, 35);
-    display->print("Heap: ");
-    display->print(ESP.getFreeHeap() / 1024);
-    display->print(" KB");
+    snprintf(rows[3], sizeof(rows[0]), "Heap: %lu KB", (unsigned long)(ESP.getFreeHeap() / 1024));
+    // Compact panels have no fifth row: the current replaces the firmware line
+    snprintf(rows[Panel::compact ? 1 : 4], sizeof(rows[0]), "OLED: %u.%u mA",
+             (unsigned)(panelCurrentTenths / 10), (unsigned)(panelCurrentTenths % 10));
+  }
+  
+  for (int i = 0; i < 5; i++) {
+    settingsRows[i].setText(rows[i]);
   }
   
-  // Page indicator
-  display->setCursor(5, 55);
-  display->print("Page ");
-  display->print(settingsPage + 1);
-  display->print("/4");
+  char page[SETTINGS_ROW_MAX];
+  snprintf(page, sizeof(page), Panel::compact ? "%d/4" : "Page %d/4", settingsPage + 1);
+  settingsPageLabel.setText(page);
 }
 
 void ScreenManager::setTime(struct tm* timeInfo) {
   if (timeInfo != nullptr) {
     this->timeInfo = *timeInfo;
     timeSynced = true;
+    invalidate(SCREEN_CLOCK);
+  }
+}
+
+void ScreenManager::setTimeSynced(bool synced) {
+  if (compositor != nullptr) {
+    compositor->setTimeSynced(synced);
+  }
+  if (synced != timeSynced) {
+    timeSynced = synced;
+    invalidate(SCREEN_CLOCK);
   }
 }
 
 void ScreenManager::setNextPrayer(String name, String time, int minutes) {
+  if (name == nextPrayerName && time == nextPrayerTime && minutes == minutesUntilPrayer) {
+    return;
+  }
   nextPrayerName = name;
   nextPrayerTime = time;
   minutesUntilPrayer = minutes;
+  invalidate(SCREEN_PRAYER_TIME);
 }
 
-void ScreenManager::setWeather(float temp, String condition, String icon, bool cached) {
+void ScreenManager::setWeather(float temp, WeatherCondition condition, bool cached) {
+  if (compositor != nullptr) {
+    compositor->setDataCached(cached);
+  }
+  if (temp == temperature && condition == weatherCondition && cached == weatherCached) {
+    return;
+  }
   temperature = temp;
+  if (condition != weatherCondition) {
+    weatherParticles.setEmitter(weatherConditionEmitter(condition));
+  }
   weatherCondition = condition;
-  weatherIcon = icon;
   weatherCached = cached;
+  if (compositor != nullptr) {
+    compositor->setBackgroundEnabled(weatherAnimated());
+  }
+  invalidate(SCREEN_WEATHER);
+}
+
+void ScreenManager::setLastWeatherUpdate(String time) {
+  if (time != lastWeatherUpdate) {
+    lastWeatherUpdate = time;
+    invalidate(SCREEN_SETTINGS);
+  }
+}
+
+void ScreenManager::setLastPrayerUpdate(String time) {
+  if (time != lastPrayerUpdate) {
+    lastPrayerUpdate = time;
+    invalidate(SCREEN_SETTINGS);
+  }
+}
+
+void ScreenManager::setLastNTPUpdate(String time) {
+  if (time != lastNTPUpdate) {
+    lastNTPUpdate = time;
+    invalidate(SCREEN_SETTINGS);
+  }
 }
 
 void ScreenManager::setWiFiInfo(String ssid, String ip, int rssi) {
+  if (compositor != nullptr) {
+    compositor->setWiFiConnected(ssid.length() > 0);
+  }
+  if (ssid == wifiSSID && ip == wifiIP && rssi == wifiRSSI) {
+    return;
+  }
   wifiSSID = ssid;
   wifiIP = ip;
   wifiRSSI = rssi;
+  invalidate(SCREEN_SETTINGS);
+}
+
+void ScreenManager::setBluetoothEnabled(bool enabled) {
+  if (compositor != nullptr) {
+    compositor->setBluetoothEnabled(enabled);
+  }
+  if (enabled != bluetoothEnabled) {
+    bluetoothEnabled = enabled;
+    invalidate(SCREEN_SETTINGS);
+  }
+}
+
+void ScreenManager::setPanelCurrent(uint32_t microamps) {
+  uint32_t tenths = (microamps + 50) / 100;
+  if (tenths > UINT16_MAX) tenths = UINT16_MAX;
+  if (tenths != panelCurrentTenths) {
+    panelCurrentTenths = tenths;
+    invalidate(SCREEN_SETTINGS);
+  }
 }
 
 void ScreenManager::nextSettingsPage() {
   settingsPage = (settingsPage + 1) % 4;
+  invalidate(SCREEN_SETTINGS);
 }
 
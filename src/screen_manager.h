@@ -9,6 +9,16 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
 #include <time.h>
+#include "mochi_display.h"
+#include "compositor.h"
+#include "weather_condition.h"
+#include "fast_font.h"
+#include "widgets.h"
+#include "anim_clock.h"
+#include "particle_system.h"
+
+#define WEATHER_PARTICLE_CAPACITY 128 // Heaviest weather scene (thunderstorm)
+#define SETTINGS_ROW_MAX 48 // Longest formatted settings row; Label::setText cuts it with "..."
 
 // Screen types
 enum ScreenType {
@@ -22,11 +32,22 @@ enum ScreenType {
 
 class ScreenManager {
 private:
-  Adafruit_SSD1306* display;
+  MochiDisplay* display;
+  Compositor* compositor; // Shared status bar (optional)
+  FastFont font;
   ScreenType currentScreen;
   unsigned long lastScreenUpdate;
   unsigned long screenUpdateInterval;
   
+  // Invalidation: one bit per ScreenType, set when that screen must be redrawn
+  uint8_t dirtyScreens;
+  ScreenType drawnScreen; // Screen whose widgets are in the buffer (SCREEN_COUNT if none)
+  int lastWidgetsDrawn;
+  time_t lastClockSecond;
+  unsigned long lastUptimeMinute;
+  unsigned long nextTimeTrigger; // millis() of the next clock/uptime change
+  bool hasTimeTrigger;
+  
   // Clock screen
   struct tm timeInfo;
   bool timeSynced;
@@ -38,9 +59,10 @@ private:
   
   // Weather screen
   float temperature;
-  String weatherCondition;
-  String weatherIcon;
+  WeatherCondition weatherCondition;
   bool weatherCached;
+  ParticleSystem weatherParticles; // Drawn into the compositor background
+  unsigned long lastParticleFrame;
   
   // Settings screen
   int settingsPage;
@@ -51,40 +73,119 @@ private:
   String wifiIP;
   int wifiRSSI;
   bool bluetoothEnabled;
+  uint16_t panelCurrentTenths; // Estimated OLED current, 0.1 mA units
+  
+  // Widget tree: one WidgetScreen per screen, values bound in bind*()
+  WidgetScreen screens[SCREEN_COUNT];
+  Label clockTime;
+  Label clockDate;
+  Label clockHint;
+  Label clockHint2;
+  Label prayerHeader;
+  Label prayerName;
+  Label prayerTime;
+  Label prayerCountdown;
+  Label prayerHint;
+  Label prayerHint2;
+  Label weatherCachedLabel;
+  BigNumber weatherTemp;
+  Label weatherName;
+  Icon weatherIcon;
+  Label weatherHint;
+  Label weatherHint2;
+  Label settingsRows[5];
+  Label settingsPageLabel;
+  
+  // Pre-rendered frames: the next screen in the cycle and Settings are
+  // rendered into spare buffers while idle so a tap can flush at once
+  Layer prerenderNext;
+  Layer prerenderSettings;
+  ScreenType prerenderNextScreen; // Screen held by prerenderNext (SCREEN_COUNT if none)
+  uint8_t prerenderValid;         // One bit per ScreenType, cleared by invalidate()
+  
+  // Tap-to-photon: setScreen() until the new screen's frame is handed to the display
+  unsigned long switchStartMicros;
+  unsigned long switchLatencyMicros;
+  bool switchPending;
+  bool lastSwitchPrerendered;
+  unsigned long prerenderHits;
+  unsigned long prerenderMisses;
   
 public:
-  ScreenManager(Adafruit_SSD1306* disp);
+  ScreenManager(MochiDisplay* disp, Compositor* comp = nullptr);
   
   // Screen navigation
   void nextScreen();
-  void setScreen(ScreenType screen);
+  void setScreen(ScreenType screen, TransitionType transition = TRANSITION_NONE);
   ScreenType getCurrentScreen() { return currentScreen; }
   
   // Update and draw
   void update();
   void draw();
   
-  // Screen-specific drawing
-  void drawRobotEyes();
-  void drawClock();
-  void drawPrayerTime();
-  void drawWeather();
-  void drawSettings();
+  // How often update() checks for invalidation (set by the frame governor)
+  void setUpdateInterval(unsigned long interval) { screenUpdateInterval = interval; }
+  
+  // Milliseconds until the current screen changes on its own (ANIM_NO_CHANGE if never)
+  unsigned long getTimeToNextChange();
+  
+  // Invalidation
+  void invalidate(ScreenType screen) {
+    dirtyScreens |= (1 << screen);
+    prerenderValid &= ~(1 << screen);
+  }
+  void invalidateAll() {
+    dirtyScreens = 0xFF;
+    prerenderValid = 0;
+  }
+  bool isDirty(ScreenType screen) { return dirtyScreens & (1 << screen); }
+  
+  // Widgets re-rasterized by the last draw() (0 when nothing changed)
+  int getLastWidgetsDrawn() { return lastWidgetsDrawn; }
+  
+  // Render one stale pre-rendered screen, if any (call when the loop is idle).
+  // Returns true if a screen was rendered.
+  bool prerenderIdle();
+  bool isPrerendered(ScreenType screen) { return prerenderValid & (1 << screen); }
+  
+  // Switch latency statistics
+  unsigned long getSwitchLatencyMicros() { return switchLatencyMicros; }
+  bool wasLastSwitchPrerendered() { return lastSwitchPrerendered; }
+  unsigned long getPrerenderHits() { return prerenderHits; }
+  unsigned long getPrerenderMisses() { return prerenderMisses; }
+  
+  // Weather animation (budget, statistics)
+  ParticleSystem* getWeatherParticles() { return &weatherParticles; }
   
   // Data setters
   void setTime(struct tm* timeInfo);
-  void setTimeSynced(bool synced) { timeSynced = synced; }
+  void setTimeSynced(bool synced);
   void setNextPrayer(String name, String time, int minutes);
-  void setWeather(float temp, String condition, String icon, bool cached = false);
-  void setLastWeatherUpdate(String time) { lastWeatherUpdate = time; }
-  void setLastPrayerUpdate(String time) { lastPrayerUpdate = time; }
-  void setLastNTPUpdate(String time) { lastNTPUpdate = time; }
+  void setWeather(float temp, WeatherCondition condition, bool cached = false);
+  void setLastWeatherUpdate(String time);
+  void setLastPrayerUpdate(String time);
+  void setLastNTPUpdate(String time);
   void setWiFiInfo(String ssid, String ip, int rssi);
-  void setBluetoothEnabled(bool enabled) { bluetoothEnabled = enabled; }
+  void setBluetoothEnabled(bool enabled);
+  void setPanelCurrent(uint32_t microamps);
   
   // Settings navigation
   void nextSettingsPage();
   int getSettingsPage() { return settingsPage; }
+  
+private:
+  void checkTimeTriggers();
+  
+  // Weather particles play on the weather screen when there is a compositor
+  bool weatherAnimated();
+  void updateWeatherLayer();
+  
+  // Push the current data into each screen's widgets
+  void bindScreen(ScreenType screen);
+  void bindClock();
+  void bindPrayerTime();
+  void bindWeather();
+  void bindSettings();
 };
 
 #endif
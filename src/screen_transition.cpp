@@ -0,0 +1,139 @@
+/*
+ * Mochi Robot - Screen Transitions Implementation
+ */
+
+#include "screen_transition.h"
+
+static_assert(Panel::height * 2 == TRANSITION_RAM_ROWS || Panel::height == TRANSITION_RAM_ROWS,
+              "Transitions expect a 64-row panel or a 32-row one with a hidden RAM half");
+
+ScreenTransition::ScreenTransition(TransitionType transition) {
+  begin(transition);
+}
+
+void ScreenTransition::begin(TransitionType transition) {
+  type = transition;
+  index = 0;
+}
+
+static void clearStep(TransitionStep& step) {
+  step.scroll = SCROLL_KEEP;
+  step.startLine = -1;
+  step.ramPage = -1;
+  step.framePage = -1;
+  step.holdMs = 0;
+}
+
+bool ScreenTransition::next(TransitionStep& step) {
+  clearStep(step);
+  switch (type) {
+    case TRANSITION_SLIDE_UP:
+    case TRANSITION_SLIDE_DOWN:
+      return Panel::compact ? nextCompactSlide(step) : nextSlide(step);
+    case TRANSITION_SCROLL_LEFT:
+    case TRANSITION_SCROLL_RIGHT:
+      return nextScroll(step);
+    case TRANSITION_SCREENSAVER:
+      return nextScreensaver(step);
+    default:
+      return false;
+  }
+}
+
+// 64-row panel: one page per step. The start line moves first, then the
+// page that just wrapped to the far edge is overwritten with new content.
+bool ScreenTransition::nextSlide(TransitionStep& step) {
+  if (index >= Panel::pages) return false;
+  index++;
+
+  int rows = index * 8;
+  if (type == TRANSITION_SLIDE_UP) {
+    step.startLine = rows % TRANSITION_RAM_ROWS;
+    step.ramPage = index - 1;
+  } else {
+    step.startLine = (TRANSITION_RAM_ROWS - rows) % TRANSITION_RAM_ROWS;
+    step.ramPage = Panel::pages - index;
+  }
+  step.framePage = step.ramPage;
+  step.holdMs = (index < Panel::pages) ? TRANSITION_STEP_MS : 0;
+  return true;
+}
+
+// 32-row panel: new frame into the hidden RAM half, slide over to it,
+// then copy it back to the visible half (unseen) and reset the start line
+bool ScreenTransition::nextCompactSlide(TransitionStep& step) {
+  const int slideSteps = Panel::height / TRANSITION_COMPACT_ROWS;
+  int i = index++;
+
+  if (i < Panel::pages) {
+    step.ramPage = Panel::pages + i;
+    step.framePage = i;
+    return true;
+  }
+  i -= Panel::pages;
+
+  if (i < slideSteps) {
+    int rows = (i + 1) * TRANSITION_COMPACT_ROWS;
+    if (type == TRANSITION_SLIDE_UP) {
+      step.startLine = rows;
+    } else {
+      step.startLine = (TRANSITION_RAM_ROWS - rows) % TRANSITION_RAM_ROWS;
+    }
+    step.holdMs = (i + 1 < slideSteps) ? TRANSITION_STEP_MS : 0;
+    return true;
+  }
+  i -= slideSteps;
+
+  if (i < Panel::pages) {
+    step.ramPage = i;
+    step.framePage = i;
+    return true;
+  }
+  i -= Panel::pages;
+
+  if (i == 0) {
+    step.startLine = 0;
+    return true;
+  }
+  return false;
+}
+
+// Scroll the old screen, stop (the controller needs RAM rewritten after
+// a scroll), then write the new frame page by page
+bool ScreenTransition::nextScroll(TransitionStep& step) {
+  int i = index++;
+
+  if (i == 0) {
+    step.scroll = (type == TRANSITION_SCROLL_LEFT) ? SCROLL_START_LEFT : SCROLL_START_RIGHT;
+    step.holdMs = TRANSITION_SCROLL_MS;
+    return true;
+  }
+  if (i == 1) {
+    step.scroll = SCROLL_STOP;
+    return true;
+  }
+  i -= 2;
+
+  if (i < Panel::pages) {
+    step.ramPage = i;
+    step.framePage = i;
+    return true;
+  }
+  return false;
+}
+
+// Write the frame, then start the diagonal scroll and leave it running
+bool ScreenTransition::nextScreensaver(TransitionStep& step) {
+  int i = index++;
+
+  if (i < Panel::pages) {
+    step.ramPage = i;
+    step.framePage = i;
+    return true;
+  }
+  if (i == Panel::pages) {
+    step.scroll = SCROLL_START_DIAGONAL;
+    return true;
+  }
+  return false;
+}
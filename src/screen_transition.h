@@ -0,0 +1,82 @@
+/*
+ * Mochi Robot - Screen Transitions
+ * Slide and scroll between screens using the SSD1306's own registers
+ *
+ * Slides move the display start line so the panel itself shifts the old
+ * screen, and each page of the new screen is written once, into the RAM
+ * page that has just wrapped out of view. 128x32 panels use the hidden
+ * half of the 64-row GDDRAM instead: the new screen is written there
+ * first and the start line slides over to it. Scrolls run the built-in
+ * horizontal scroll on the old screen, then write the new one. The
+ * screensaver writes its frame once and leaves the diagonal scroll
+ * running: rows and columns wrap, so it drifts for as long as it is up.
+ *
+ * Either way the CPU never renders an intermediate frame and the bus
+ * carries about one frame of data. ScreenTransition only plans the steps;
+ * DisplayFlush::transition() sends them.
+ */
+
+#ifndef SCREEN_TRANSITION_H
+#define SCREEN_TRANSITION_H
+
+#include <Arduino.h>
+#include "display_geometry.h"
+
+enum TransitionType : uint8_t {
+  TRANSITION_NONE = 0,
+  TRANSITION_SLIDE_UP,     // New screen enters from the bottom
+  TRANSITION_SLIDE_DOWN,   // New screen enters from the top
+  TRANSITION_SCROLL_LEFT,  // Old screen scrolls away, then the new one is shown
+  TRANSITION_SCROLL_RIGHT,
+  TRANSITION_SCREENSAVER   // Frame is written, then left scrolling diagonally (sleep)
+};
+
+enum TransitionScroll : uint8_t {
+  SCROLL_KEEP = 0,
+  SCROLL_START_LEFT,
+  SCROLL_START_RIGHT,
+  SCROLL_START_DIAGONAL,   // Up and to the right, whole panel
+  SCROLL_STOP
+};
+
+#define TRANSITION_STEP_MS 30         // Per start-line step
+#define TRANSITION_COMPACT_ROWS 4     // Start-line step on 128x32 panels
+#define TRANSITION_SCROLL_MS 250      // Hardware scroll time before the cut
+#define TRANSITION_SCROLL_INTERVAL 7  // SSD1306 interval code 7 = every 2 panel frames
+#define SCREENSAVER_SCROLL_INTERVAL 6 // Interval code 6 = every 25 panel frames (~4 steps/s)
+#define SCREENSAVER_SCROLL_OFFSET 1   // Rows moved up per step
+
+// GDDRAM is always 64 rows, whatever the panel shows
+#define TRANSITION_RAM_ROWS 64
+
+// One step, applied in field order: scroll, start line, page write, hold
+struct TransitionStep {
+  uint8_t scroll;    // TransitionScroll
+  int8_t startLine;  // -1 = unchanged
+  int8_t ramPage;    // GDDRAM page to write, -1 = none
+  int8_t framePage;  // Page of the new frame written there
+  uint16_t holdMs;   // Wait before the next step
+};
+
+class ScreenTransition {
+private:
+  TransitionType type;
+  int index;
+
+  bool nextSlide(TransitionStep& step);
+  bool nextCompactSlide(TransitionStep& step);
+  bool nextScroll(TransitionStep& step);
+  bool nextScreensaver(TransitionStep& step);
+
+public:
+  ScreenTransition(TransitionType transition = TRANSITION_NONE);
+
+  void begin(TransitionType transition);
+  TransitionType getType() { return type; }
+
+  // Fill in the next step; false once the new frame is fully on screen
+  // with the start line back at 0 (and, for the screensaver, scrolling)
+  bool next(TransitionStep& step);
+};
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * Mochi Robot - Sleep Screensaver Implementation
+ */
+
+#include "sleep_screensaver.h"
+#include "fb_primitives.h"
+#include <driver/gpio.h>
+#include <esp_sleep.h>
+
+SleepScreensaver::SleepScreensaver(uint8_t touchPin) : scene(Panel::width, Panel::height) {
+  shown = false;
+  wakePin = touchPin;
+  showCount = 0;
+  lightSleepCount = 0;
+  lightSleepMillis = 0;
+}
+
+// Top bar, diagonal from top right to bottom left, bottom bar
+void SleepScreensaver::drawZ(int x, int y, int size) {
+  fbDrawHLine(&scene, x, y, size, SSD1306_WHITE);
+  for (int i = 1; i < size - 1; i++) {
+    scene.drawPixel(x + size - 1 - i, y + i, SSD1306_WHITE);
+  }
+  fbDrawHLine(&scene, x, y + size - 1, size, SSD1306_WHITE);
+}
+
+void SleepScreensaver::render(uint32_t seed) {
+  if (!scene.isValid()) return;
+  scene.clearDisplay();
+
+  // xorshift32, as in ParticleSystem: the same seed gives the same sky
+  uint32_t state = seed ? seed : 1;
+  for (int i = 0; i < SCREENSAVER_STARS; i++) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    int x = (int)(((state >> 16) * Panel::width) >> 16);
+    int y = (int)(((state & 0xFFFF) * Panel::height) >> 16);
+    scene.drawPixel(x, y, SSD1306_WHITE);
+    if (i < SCREENSAVER_BRIGHT_STARS) {
+      scene.drawPixel(x - 1, y, SSD1306_WHITE);
+      scene.drawPixel(x + 1, y, SSD1306_WHITE);
+      scene.drawPixel(x, y - 1, SSD1306_WHITE);
+      scene.drawPixel(x, y + 1, SSD1306_WHITE);
+    }
+  }
+
+  // Zzz rising to the upper right, each one bigger; the scroll carries
+  // them further along the same diagonal
+  int size = Panel::layout(5, 3);
+  int x = Panel::centerX - Panel::layout(16, 12);
+  int y = Panel::centerY + Panel::layout(8, 4);
+  for (int i = 0; i < 3; i++) {
+    fbFillRect(&scene, x - 1, y - 1, size + 2, size + 2, SSD1306_BLACK); // Keep stars off the letter
+    drawZ(x, y, size);
+    x += size + Panel::layout(4, 3);
+    y -= size + Panel::layout(3, 1);
+    size += Panel::layout(2, 1);
+  }
+}
+
+bool SleepScreensaver::show(MochiDisplay* display) {
+  if (shown) return true;
+  if (display->isFrameInFlight()) return false;
+
+  shown = true;
+  if (!scene.isValid()) return true; // No scene buffer: the dimmed screen stays up
+  display->showScreensaver(scene.getBuffer());
+  showCount++;
+  return true;
+}
+
+void SleepScreensaver::hide(MochiDisplay* display) {
+  if (!shown) return;
+  shown = false;
+  // The back buffer still holds the last screen; presenting it stops the scroll
+  display->display();
+}
+
+bool SleepScreensaver::lightSleep(MochiDisplay* display, unsigned long ms) {
+  if (!shown || display->isFrameInFlight()) return false;
+
+  // The touch input is high while touched; the panel keeps scrolling on its own
+  gpio_wakeup_enable((gpio_num_t)wakePin, GPIO_INTR_HIGH_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+  esp_sleep_enable_timer_wakeup((uint64_t)ms * 1000);
+  Serial.flush(); // The UART stops while asleep
+
+  unsigned long start = millis();
+  bool slept = esp_light_sleep_start() == ESP_OK;
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+  gpio_wakeup_disable((gpio_num_t)wakePin);
+
+  if (slept) {
+    lightSleepCount++;
+    lightSleepMillis += millis() - start;
+  }
+  return slept;
+}
@@ -0,0 +1,68 @@
+/*
+ * Mochi Robot - Sleep Screensaver
+ * Starfield and drifting "Zzz" animated by the SSD1306 itself while asleep
+ *
+ * The scene is rendered once into its own layer and handed to
+ * MochiDisplay::showScreensaver(): the frame is written, then the
+ * controller's continuous diagonal scroll moves it up and to the right
+ * with rows and columns wrapping around. Nothing is drawn or sent per
+ * frame, so once the dim has finished loop() calls lightSleep() between
+ * its housekeeping ticks: esp_light_sleep_start() with a timer wake and a
+ * GPIO wake on the touch pin, so a tap wakes the CPU at once. This works
+ * on stock Arduino-ESP32 cores (no tickless idle or power management
+ * config needed). WiFi stays associated across naps this short; BLE
+ * advertising does not, so main skips the sleep while BLE setup is on.
+ */
+
+#ifndef SLEEP_SCREENSAVER_H
+#define SLEEP_SCREENSAVER_H
+
+#include <Arduino.h>
+#include "display_geometry.h"
+#include "compositor.h"
+#include "mochi_display.h"
+
+#define SCREENSAVER_STARS Panel::layout(28, 14)
+#define SCREENSAVER_BRIGHT_STARS 4 // Drawn as small crosses
+#define SCREENSAVER_SLEEP_MS 1000   // Longest light sleep; loop() runs in between
+
+class SleepScreensaver {
+private:
+  Layer scene;
+  bool shown;
+  uint8_t wakePin;
+
+  // Statistics
+  unsigned long showCount;
+  unsigned long lightSleepCount;
+  unsigned long lightSleepMillis;
+
+  void drawZ(int x, int y, int size);
+
+public:
+  SleepScreensaver(uint8_t touchPin);
+
+  // Draw the scene; the seed places the stars
+  void render(uint32_t seed);
+  const uint8_t* getFrame() { return scene.getBuffer(); }
+
+  // Put the scene on the panel and leave it drifting. Returns false (try
+  // again next loop) while a frame is still on the bus.
+  bool show(MochiDisplay* display);
+
+  // Bring the screen back: the next frame stops the scroll and rewrites the panel
+  void hide(MochiDisplay* display);
+  bool isShown() { return shown; }
+
+  // Light-sleep the CPU for up to `ms`, waking early when the touch pin
+  // goes high. Only while the scene is up and no frame is on the bus;
+  // returns false without sleeping otherwise.
+  bool lightSleep(MochiDisplay* display, unsigned long ms);
+
+  // Statistics
+  unsigned long getShowCount() { return showCount; }
+  unsigned long getLightSleepCount() { return lightSleepCount; }
+  unsigned long getLightSleepMillis() { return lightSleepMillis; }
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Mochi Robot - Sprite Cache Implementation
+ */
+
+#include "sprite_cache.h"
+
+SpriteCache::SpriteCache(size_t budget, uint8_t width, uint8_t pages) {
+  frameWidth = width;
+  framePages = pages;
+  byteBudget = budget;
+  bytesUsed = 0;
+  useCounter = 0;
+  hits = 0;
+  misses = 0;
+  evictions = 0;
+  for (int i = 0; i < SPRITE_CACHE_SLOTS; i++) {
+    entries[i].used = false;
+    entries[i].data = nullptr;
+  }
+}
+
+SpriteCache::~SpriteCache() {
+  clear();
+}
+
+SpriteCache::Entry* SpriteCache::find(uint32_t key) {
+  for (int i = 0; i < SPRITE_CACHE_SLOTS; i++) {
+    if (entries[i].used && entries[i].key == key) {
+      return &entries[i];
+    }
+  }
+  return nullptr;
+}
+
+void SpriteCache::evict(Entry* entry) {
+  if (!entry->used) return;
+  bytesUsed -= (size_t)entry->pageCount * entry->colCount;
+  free(entry->data);
+  entry->data = nullptr;
+  entry->used = false;
+}
+
+SpriteCache::Entry* SpriteCache::evictLeastRecent() {
+  Entry* oldest = nullptr;
+  for (int i = 0; i < SPRITE_CACHE_SLOTS; i++) {
+    if (entries[i].used && (oldest == nullptr || entries[i].lastUsed < oldest->lastUsed)) {
+      oldest = &entries[i];
+    }
+  }
+  if (oldest != nullptr) {
+    evict(oldest);
+    evictions++;
+  }
+  return oldest;
+}
+
+bool SpriteCache::blit(uint32_t key, uint8_t* frame) {
+  Entry* entry = find(key);
+  if (entry == nullptr) {
+    misses++;
+    return false;
+  }
+
+  hits++;
+  entry->lastUsed = ++useCounter;
+
+  memset(frame, 0, (size_t)frameWidth * framePages);
+  const uint8_t* src = entry->data;
+  for (uint8_t page = 0; page < entry->pageCount; page++) {
+    memcpy(frame + (entry->pageStart + page) * frameWidth + entry->colStart, src, entry->colCount);
+    src += entry->colCount;
+  }
+  return true;
+}
+
+void SpriteCache::store(uint32_t key, const uint8_t* frame) {
+  Entry* existing = find(key);
+  if (existing != nullptr) {
+    evict(existing);
+  }
+
+  // Crop to the pages and columns that hold lit pixels
+  int firstPage = -1, lastPage = -1;
+  int firstCol = frameWidth, lastCol = -1;
+  for (int page = 0; page < framePages; page++) {
+    const uint8_t* row = frame + page * frameWidth;
+    for (int col = 0; col < frameWidth; col++) {
+      if (row[col] != 0) {
+        if (firstPage < 0) firstPage = page;
+        lastPage = page;
+        if (col < firstCol) firstCol = col;
+        if (col > lastCol) lastCol = col;
+      }
+    }
+  }
+
+  uint8_t pageCount = (firstPage < 0) ? 0 : lastPage - firstPage + 1;
+  uint8_t colCount = (firstPage < 0) ? 0 : lastCol - firstCol + 1;
+  size_t size = (size_t)pageCount * colCount;
+  if (size > byteBudget) {
+    return; // Would never fit
+  }
+
+  // Make room: budget first, then a free slot
+  while (bytesUsed + size > byteBudget) {
+    if (evictLeastRecent() == nullptr) return;
+  }
+  Entry* slot = nullptr;
+  for (int i = 0; i < SPRITE_CACHE_SLOTS && slot == nullptr; i++) {
+    if (!entries[i].used) slot = &entries[i];
+  }
+  if (slot == nullptr) {
+    slot = evictLeastRecent();
+  }
+
+  uint8_t* data = nullptr;
+  if (size > 0) {
+    data = (uint8_t*)malloc(size);
+    if (data == nullptr) return;
+    uint8_t* dst = data;
+    for (uint8_t page = 0; page < pageCount; page++) {
+      memcpy(dst, frame + (firstPage + page) * frameWidth + firstCol, colCount);
+      dst += colCount;
+    }
+  }
+
+  slot->key = key;
+  slot->used = true;
+  slot->pageStart = (firstPage < 0) ? 0 : firstPage;
+  slot->pageCount = pageCount;
+  slot->colStart = (firstPage < 0) ? 0 : firstCol;
+  slot->colCount = colCount;
+  slot->data = data;
+  slot->lastUsed = ++useCounter;
+  bytesUsed += size;
+}
+
+void SpriteCache::clear() {
+  for (int i = 0; i < SPRITE_CACHE_SLOTS; i++) {
+    evict(&entries[i]);
+  }
+}
+
+void SpriteCache::setByteBudget(size_t budget) {
+  byteBudget = budget;
+  while (bytesUsed > byteBudget) {
+    if (evictLeastRecent() == nullptr) break;
+  }
+}
@@ -0,0 +1,76 @@
+/*
+ * Mochi Robot - Sprite Cache
+ * Keeps rendered 1bpp frames in RAM and blits them back page-aligned
+ *
+ * Sprites are stored in SSD1306 page order, cropped to the pages and
+ * columns that contain lit pixels. Least recently used sprites are
+ * evicted to stay within the byte budget.
+ */
+
+#ifndef SPRITE_CACHE_H
+#define SPRITE_CACHE_H
+
+#include <Arduino.h>
+#include "display_geometry.h"
+
+#define SPRITE_CACHE_SLOTS 16
+
+class SpriteCache {
+private:
+  struct Entry {
+    uint32_t key;
+    bool used;
+    uint8_t pageStart;
+    uint8_t pageCount;
+    uint8_t colStart;
+    uint8_t colCount;
+    uint8_t* data;
+    unsigned long lastUsed;
+  };
+
+  Entry entries[SPRITE_CACHE_SLOTS];
+  uint8_t frameWidth;
+  uint8_t framePages;
+  size_t byteBudget;
+  size_t bytesUsed;
+  unsigned long useCounter;
+
+  // Statistics
+  unsigned long hits;
+  unsigned long misses;
+  unsigned long evictions;
+
+  Entry* find(uint32_t key);
+  void evict(Entry* entry);
+  Entry* evictLeastRecent();
+
+public:
+  SpriteCache(size_t budget = 2048, uint8_t width = Panel::width, uint8_t pages = Panel::pages);
+  ~SpriteCache();
+
+  // Build a key from the face, its animation phase and its size
+  static uint32_t makeKey(uint8_t type, uint8_t phase, uint8_t size) {
+    return ((uint32_t)type << 16) | ((uint32_t)phase << 8) | size;
+  }
+
+  // Copy a cached sprite into the frame (clearing the rest); false on miss
+  bool blit(uint32_t key, uint8_t* frame);
+
+  // Capture the lit area of a freshly rendered frame under this key
+  void store(uint32_t key, const uint8_t* frame);
+
+  // Drop all sprites
+  void clear();
+
+  // Budget
+  void setByteBudget(size_t budget);
+  size_t getByteBudget() { return byteBudget; }
+  size_t getBytesUsed() { return bytesUsed; }
+
+  // Statistics
+  unsigned long getHits() { return hits; }
+  unsigned long getMisses() { return misses; }
+  unsigned long getEvictions() { return evictions; }
+};
+
+#endif
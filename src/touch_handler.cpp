@@ -11,6 +11,7 @@ TouchHandler::TouchHandler(int pin) {
   currentTouchState = false;
   touchStartTime = 0;
   lastTapTime = 0;
+  lastReleaseTime = 0;
   tapTimeout = 0;
   tapCount = 0;
   longPressDetected = false;
@@ -31,6 +32,7 @@ void TouchHandler::update() {
   
   // Detect touch end
   if (!currentTouchState && lastTouchState) {
+    lastReleaseTime = now;
     unsigned long pressDuration = now - touchStartTime;
     
     // Check for long press (detected on release after 1.5s)
@@ -21,6 +21,7 @@ private:
   bool currentTouchState;
   unsigned long touchStartTime;
   unsigned long lastTapTime;
+  unsigned long lastReleaseTime;
   unsigned long tapTimeout;
   int tapCount;
   bool longPressDetected;
@@ -41,6 +42,9 @@ public:
   // Check if currently touching
   bool isTouching() { return currentTouchState; }
   
+  // millis() when the finger last left the pad (start of tap-to-photon)
+  unsigned long getLastReleaseTime() { return lastReleaseTime; }
+  
   // Reset touch state
   void reset();
 };
@@ -92,53 +92,52 @@ bool WeatherAPI::parseWeatherResponse(String json, WeatherData* data) {
     return false;
   }
   
-  // Extract condition
+  // Extract condition from the numeric OWM id (e.g. 500 = light rain)
+  data->condition = WEATHER_UNKNOWN;
   if (doc.containsKey("weather") && doc["weather"].is<JsonArray>()) {
     JsonArray weatherArray = doc["weather"].as<JsonArray>();
     if (weatherArray.size() > 0) {
-      data->condition = weatherArray[0]["main"].as<String>();
-      data->icon = weatherArray[0]["icon"].as<String>();
-    }
-  }
-  
-  // Map icon to emoji/symbol
-  if (data->icon.length() > 0) {
-    if (data->icon.startsWith("01")) {
-      data->icon = "☀"; // Clear sky
-    } else if (data->icon.startsWith("02")) {
-      data->icon = "⛅"; // Few clouds
-    } else if (data->icon.startsWith("03") || data->icon.startsWith("04")) {
-      data->icon = "☁"; // Clouds
-    } else if (data->icon.startsWith("09") || data->icon.startsWith("10")) {
-      data->icon = "🌧"; // Rain
-    } else if (data->icon.startsWith("11")) {
-      data->icon = "⛈"; // Thunderstorm
-    } else if (data->icon.startsWith("13")) {
-      data->icon = "❄"; // Snow
-    } else if (data->icon.startsWith("50")) {
-      data->icon = "🌫"; // Mist
-    } else {
-      data->icon = "🌤"; // Default
+      data->condition = weatherConditionFromId(weatherArray[0]["id"] | 0);
     }
   }
   
   Serial.print("🌡️ Temperature: ");
   Serial.print(data->temperature);
   Serial.print("°C, Condition: ");
-  Serial.println(data->condition);
+  Serial.println(weatherConditionName(data->condition));
   
   return true;
 }
 
+// Older firmware cached the OWM "main" text and an emoji icon as strings
+// ("weather_cond", "weather_icon"), then the condition byte as "weather_id".
+// Carry the byte over and delete whatever is left of those layouts.
+void WeatherAPI::migrateCachedWeather() {
+  preferences->begin("mochi", false);
+  if (preferences->getType("weather_cond") == PT_STR) {
+    preferences->remove("weather_cond");
+  }
+  if (preferences->isKey("weather_icon")) {
+    preferences->remove("weather_icon");
+  }
+  if (preferences->isKey("weather_id")) {
+    preferences->putUChar("weather_cond", preferences->getUChar("weather_id", WEATHER_UNKNOWN));
+    preferences->remove("weather_id");
+  }
+  preferences->end();
+}
+
 bool WeatherAPI::loadCachedWeather(WeatherData* data) {
+  migrateCachedWeather();
+  
   preferences->begin("mochi", true);
   data->temperature = preferences->getFloat("weather_temp", 0.0);
-  data->condition = preferences->getString("weather_cond", "");
-  data->icon = preferences->getString("weather_icon", "");
+  uint8_t condition = preferences->getUChar("weather_cond", WEATHER_UNKNOWN);
+  data->condition = condition < WEATHER_CONDITION_COUNT ? (WeatherCondition)condition : WEATHER_UNKNOWN;
   data->lastUpdate = preferences->getULong64("weather_time", 0);
   preferences->end();
   
-  if (data->temperature != 0.0 || data->condition.length() > 0) {
+  if (data->temperature != 0.0 || data->condition != WEATHER_UNKNOWN) {
     data->cached = true;
     Serial.println("📦 Loaded cached weather data");
     return true;
@@ -150,8 +149,7 @@ bool WeatherAPI::loadCachedWeather(WeatherData* data) {
 void WeatherAPI::saveCachedWeather(WeatherData* data) {
   preferences->begin("mochi", false);
   preferences->putFloat("weather_temp", data->temperature);
-  preferences->putString("weather_cond", data->condition);
-  preferences->putString("weather_icon", data->icon);
+  preferences->putUChar("weather_cond", data->condition);
   preferences->putULong64("weather_time", data->lastUpdate);
   preferences->end();
   
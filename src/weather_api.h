@@ -10,11 +10,11 @@
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 #include <Preferences.h>
+#include "weather_condition.h"
 
 struct WeatherData {
   float temperature;
-  String condition;
-  String icon;
+  WeatherCondition condition;
   bool cached;
   unsigned long lastUpdate;
 };
@@ -29,6 +29,7 @@ private:
   static const unsigned long UPDATE_INTERVAL = 1800000; // 30 minutes
   
   bool parseWeatherResponse(String json, WeatherData* data);
+  void migrateCachedWeather();
   
 public:
   WeatherAPI(Preferences* prefs);
@@ -0,0 +1,70 @@
+/*
+ * Mochi Robot - Weather Conditions Implementation
+ */
+
+#include "weather_condition.h"
+#include "assets_generated.h"
+
+WeatherCondition weatherConditionFromId(int owmId) {
+  // Condition groups: https://openweathermap.org/weather-conditions
+  if (owmId >= 200 && owmId < 300) return WEATHER_THUNDERSTORM;
+  if (owmId >= 300 && owmId < 400) return WEATHER_DRIZZLE;
+  if (owmId >= 500 && owmId < 600) return WEATHER_RAIN;
+  if (owmId >= 600 && owmId < 700) return WEATHER_SNOW;
+  if (owmId >= 700 && owmId < 800) return WEATHER_MIST;
+  if (owmId == 800) return WEATHER_CLEAR;
+  if (owmId == 801 || owmId == 802) return WEATHER_FEW_CLOUDS;
+  if (owmId == 803 || owmId == 804) return WEATHER_CLOUDS;
+  return WEATHER_UNKNOWN;
+}
+
+const char* weatherConditionName(WeatherCondition condition) {
+  switch(condition) {
+    case WEATHER_CLEAR: return "Clear";
+    case WEATHER_FEW_CLOUDS: return "Few clouds";
+    case WEATHER_CLOUDS: return "Clouds";
+    case WEATHER_DRIZZLE: return "Drizzle";
+    case WEATHER_RAIN: return "Rain";
+    case WEATHER_THUNDERSTORM: return "Thunderstorm";
+    case WEATHER_SNOW: return "Snow";
+    case WEATHER_MIST: return "Mist";
+    default: return "Unknown";
+  }
+}
+
+const PackedAsset& weatherConditionIcon(WeatherCondition condition, bool large) {
+  switch(condition) {
+    case WEATHER_CLEAR: return large ? ASSET_WEATHER_CLEAR_32 : ASSET_WEATHER_CLEAR_16;
+    case WEATHER_FEW_CLOUDS: return large ? ASSET_WEATHER_FEW_CLOUDS_32 : ASSET_WEATHER_FEW_CLOUDS_16;
+    case WEATHER_CLOUDS: return large ? ASSET_WEATHER_CLOUDS_32 : ASSET_WEATHER_CLOUDS_16;
+    case WEATHER_DRIZZLE: return large ? ASSET_WEATHER_DRIZZLE_32 : ASSET_WEATHER_DRIZZLE_16;
+    case WEATHER_RAIN: return large ? ASSET_WEATHER_RAIN_32 : ASSET_WEATHER_RAIN_16;
+    case WEATHER_THUNDERSTORM: return large ? ASSET_WEATHER_THUNDERSTORM_32 : ASSET_WEATHER_THUNDERSTORM_16;
+    case WEATHER_SNOW: return large ? ASSET_WEATHER_SNOW_32 : ASSET_WEATHER_SNOW_16;
+    case WEATHER_MIST: return large ? ASSET_WEATHER_MIST_32 : ASSET_WEATHER_MIST_16;
+    default: return large ? ASSET_WEATHER_UNKNOWN_32 : ASSET_WEATHER_UNKNOWN_16;
+  }
+}
+
+// Style, count, vx, vy (Q6 px per frame), size, sway. Compact panels get half the particles.
+static const ParticleEmitter EMITTER_NONE = {PARTICLE_DOT, 0, 0, 0, 0, 0, 1, 1, 0};
+static const ParticleEmitter EMITTER_FEW_CLOUDS = {PARTICLE_PUFF, Panel::layout(4, 2), 6, 10, 0, 0, 10, 18, 0};
+static const ParticleEmitter EMITTER_CLOUDS = {PARTICLE_PUFF, Panel::layout(8, 4), 4, 10, 0, 0, 12, 24, 0};
+static const ParticleEmitter EMITTER_DRIZZLE = {PARTICLE_STREAK, Panel::layout(40, 20), 0, 4, 80, 112, 2, 2, 0};
+static const ParticleEmitter EMITTER_RAIN = {PARTICLE_STREAK, Panel::layout(96, 48), 0, 8, 160, 224, 3, 5, 0};
+static const ParticleEmitter EMITTER_THUNDERSTORM = {PARTICLE_STREAK, Panel::layout(128, 64), 8, 16, 224, 288, 4, 6, 0};
+static const ParticleEmitter EMITTER_SNOW = {PARTICLE_DOT, Panel::layout(64, 32), -8, 8, 24, 48, 1, 1, 4};
+static const ParticleEmitter EMITTER_MIST = {PARTICLE_BAND, Panel::layout(10, 5), 2, 6, 0, 0, 24, 48, 0};
+
+const ParticleEmitter& weatherConditionEmitter(WeatherCondition condition) {
+  switch(condition) {
+    case WEATHER_FEW_CLOUDS: return EMITTER_FEW_CLOUDS;
+    case WEATHER_CLOUDS: return EMITTER_CLOUDS;
+    case WEATHER_DRIZZLE: return EMITTER_DRIZZLE;
+    case WEATHER_RAIN: return EMITTER_RAIN;
+    case WEATHER_THUNDERSTORM: return EMITTER_THUNDERSTORM;
+    case WEATHER_SNOW: return EMITTER_SNOW;
+    case WEATHER_MIST: return EMITTER_MIST;
+    default: return EMITTER_NONE; // Clear sky and no data stay still
+  }
+}
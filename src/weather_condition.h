@@ -0,0 +1,38 @@
+/*
+ * Mochi Robot - Weather Conditions
+ * Compact condition model parsed from OpenWeatherMap condition ids
+ */
+
+#ifndef WEATHER_CONDITION_H
+#define WEATHER_CONDITION_H
+
+#include <stdint.h>
+#include "asset_blit.h"
+#include "particle_system.h"
+
+enum WeatherCondition : uint8_t {
+  WEATHER_UNKNOWN = 0,
+  WEATHER_CLEAR,
+  WEATHER_FEW_CLOUDS,
+  WEATHER_CLOUDS,
+  WEATHER_DRIZZLE,
+  WEATHER_RAIN,
+  WEATHER_THUNDERSTORM,
+  WEATHER_SNOW,
+  WEATHER_MIST,
+  WEATHER_CONDITION_COUNT
+};
+
+// Map an OWM "weather[0].id" (e.g. 500 = light rain) to a condition
+WeatherCondition weatherConditionFromId(int owmId);
+
+// Short display name ("Rain", "Clouds", ...)
+const char* weatherConditionName(WeatherCondition condition);
+
+// 1bpp icon for a condition; large = 32x32, otherwise 16x16
+const PackedAsset& weatherConditionIcon(WeatherCondition condition, bool large);
+
+// Particle scene for a condition (count 0 = static screen)
+const ParticleEmitter& weatherConditionEmitter(WeatherCondition condition);
+
+#endif
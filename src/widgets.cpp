@@ -0,0 +1,182 @@
+/*
+ * Mochi Robot - Retained Widgets Implementation
+ */
+
+#include "widgets.h"
+#include "fb_primitives.h"
+
+static uint8_t clampWidth(int x, int w) {
+  if (x + w > WIDGET_AREA_WIDTH) w = WIDGET_AREA_WIDTH - x;
+  return w < 0 ? 0 : w;
+}
+
+Widget::Widget(int x, int y, int w, int h) {
+  this->x = x;
+  this->y = y;
+  width = clampWidth(x, w);
+  height = h;
+  dirty = true;
+  visible = true;
+}
+
+void Widget::setVisible(bool show) {
+  if (show != visible) {
+    visible = show;
+    dirty = true;
+  }
+}
+
+bool Widget::overlaps(const Widget& other) const {
+  return x < other.x + other.width && other.x < x + width &&
+         y < other.y + other.height && other.y < y + height;
+}
+
+void Widget::clear(Adafruit_SSD1306* display) {
+  fbFillRect(display, x, y, width, height, SSD1306_BLACK);
+}
+
+void Widget::draw(Adafruit_SSD1306* display, FastFont* font) {
+  if (visible) {
+    render(display, font);
+  }
+  dirty = false;
+}
+
+// ==================== Label ====================
+
+Label::Label(int x, int y, uint8_t maxChars, uint8_t scale)
+  : Widget(x, y, fontTextWidth(maxChars, scale), fontTextHeight(scale)) {
+  this->maxChars = maxChars < WIDGET_TEXT_MAX ? maxChars : WIDGET_TEXT_MAX - 1;
+  this->scale = scale;
+  text[0] = '\0';
+}
+
+void Label::setText(const char* value) {
+  char fitted[WIDGET_TEXT_MAX];
+  size_t length = strlen(value);
+  if (length > maxChars) {
+    // Keep the start and mark the cut
+    memcpy(fitted, value, maxChars - 3);
+    memcpy(fitted + maxChars - 3, "...", 4);
+  } else {
+    memcpy(fitted, value, length + 1);
+  }
+
+  if (strcmp(fitted, text) != 0) {
+    strcpy(text, fitted);
+    dirty = true;
+  }
+}
+
+void Label::render(Adafruit_SSD1306* /*display*/, FastFont* font) {
+  font->drawText(x, y, text, scale);
+}
+
+// ==================== BigNumber ====================
+
+BigNumber::BigNumber(int x, int y, uint8_t maxChars, uint8_t scale, uint8_t decimals, const char* unit)
+  : Widget(x, y, fontTextWidth(maxChars, scale) + fontTextWidth(strlen(unit), scale > 1 ? scale - 1 : 1),
+           fontTextHeight(scale)) {
+  this->maxChars = maxChars;
+  this->scale = scale;
+  this->decimals = decimals;
+  this->unit = unit;
+  value = 0.0;
+  hasValue = false;
+}
+
+void BigNumber::setValue(float newValue) {
+  if (hasValue && newValue == value) return;
+  value = newValue;
+  hasValue = true;
+  dirty = true;
+}
+
+void BigNumber::clearValue() {
+  if (!hasValue) return;
+  hasValue = false;
+  dirty = true;
+}
+
+void BigNumber::render(Adafruit_SSD1306* /*display*/, FastFont* font) {
+  if (!hasValue) return;
+  char number[12];
+  int length = snprintf(number, sizeof(number), "%.*f", decimals, value);
+  if (length > maxChars) {
+    length = snprintf(number, sizeof(number), "%.0f", value);
+  }
+  if (length > maxChars && maxChars < sizeof(number)) {
+    number[maxChars] = '\0'; // Keep inside the bounds
+  }
+  int endX = font->drawText(x, y, number, scale);
+  font->drawText(endX, y, unit, scale > 1 ? scale - 1 : 1);
+}
+
+// ==================== Icon ====================
+
+Icon::Icon(int x, int y, int w, int h) : Widget(x, y, w, h) {
+  asset = nullptr;
+}
+
+void Icon::setAsset(const PackedAsset* newAsset) {
+  if (newAsset != asset) {
+    asset = newAsset;
+    dirty = true;
+  }
+}
+
+void Icon::render(Adafruit_SSD1306* display, FastFont* /*font*/) {
+  if (asset != nullptr) {
+    blitAsset(display, *asset, x, y);
+  }
+}
+
+// ==================== WidgetScreen ====================
+
+WidgetScreen::WidgetScreen() {
+  count = 0;
+}
+
+void WidgetScreen::add(Widget* widget) {
+  if (count < WIDGET_SCREEN_MAX) {
+    widgets[count++] = widget;
+  }
+}
+
+int WidgetScreen::draw(Adafruit_SSD1306* display, FastFont* font, bool full) {
+  if (full) {
+    // Caller cleared the buffer
+    for (uint8_t i = 0; i < count; i++) {
+      widgets[i]->draw(display, font);
+    }
+    return count;
+  }
+
+  // Clearing a dirty widget erases whatever it overlaps, so pull those in too
+  bool grew = true;
+  while (grew) {
+    grew = false;
+    for (uint8_t i = 0; i < count; i++) {
+      if (!widgets[i]->isDirty()) continue;
+      for (uint8_t j = 0; j < count; j++) {
+        if (!widgets[j]->isDirty() && widgets[i]->overlaps(*widgets[j])) {
+          widgets[j]->invalidate();
+          grew = true;
+        }
+      }
+    }
+  }
+
+  // Clear everything first so a later clear can't wipe an earlier render
+  int drawn = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (widgets[i]->isDirty()) widgets[i]->clear(display);
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    if (widgets[i]->isDirty()) {
+      widgets[i]->draw(display, font);
+      drawn++;
+    }
+  }
+  return drawn;
+}
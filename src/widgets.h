@@ -0,0 +1,108 @@
+/*
+ * Mochi Robot - Retained Widgets
+ * Small widget tree for the ScreenManager screens
+ *
+ * Widgets keep their last value and bounds. Setters only mark a widget
+ * dirty when the value really changed, and WidgetScreen::draw() clears
+ * and re-rasterizes just the dirty widgets (plus any widget overlapping
+ * them), leaving the rest of the buffer untouched for DisplayFlush to skip.
+ */
+
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include <Adafruit_SSD1306.h>
+#include "fast_font.h"
+#include "asset_blit.h"
+
+#define WIDGET_TEXT_MAX 22   // 21 columns of size-1 text + terminator
+#define WIDGET_SCREEN_MAX 10
+#define WIDGET_AREA_WIDTH Panel::width // Bounds are clipped to the panel width
+
+class Widget {
+protected:
+  int16_t x, y;
+  uint8_t width, height;
+  bool dirty;
+  bool visible;
+
+  virtual void render(Adafruit_SSD1306* display, FastFont* font) = 0;
+
+public:
+  Widget(int x, int y, int w, int h);
+  virtual ~Widget() {}
+
+  void setVisible(bool show);
+  void invalidate() { dirty = true; }
+  bool isDirty() { return dirty; }
+  bool overlaps(const Widget& other) const;
+
+  // Blank the bounds, then re-rasterize into them (clears the dirty flag)
+  void clear(Adafruit_SSD1306* display);
+  void draw(Adafruit_SSD1306* display, FastFont* font);
+};
+
+// One line of FastFont text, truncated with "..." to its width
+class Label : public Widget {
+private:
+  char text[WIDGET_TEXT_MAX];
+  uint8_t scale;
+  uint8_t maxChars;
+
+protected:
+  void render(Adafruit_SSD1306* display, FastFont* font);
+
+public:
+  Label(int x, int y, uint8_t maxChars, uint8_t scale = 1);
+  void setText(const char* value);
+};
+
+// Large number with decimals and a smaller unit suffix (e.g. "23.5C");
+// numbers longer than maxChars drop the decimals
+class BigNumber : public Widget {
+private:
+  float value;
+  bool hasValue;
+  uint8_t maxChars;
+  uint8_t scale;
+  uint8_t decimals;
+  const char* unit;
+
+protected:
+  void render(Adafruit_SSD1306* display, FastFont* font);
+
+public:
+  BigNumber(int x, int y, uint8_t maxChars, uint8_t scale, uint8_t decimals, const char* unit);
+  void setValue(float newValue);
+  void clearValue();
+};
+
+// Flash bitmap from assets_generated.h
+class Icon : public Widget {
+private:
+  const PackedAsset* asset;
+
+protected:
+  void render(Adafruit_SSD1306* display, FastFont* font);
+
+public:
+  Icon(int x, int y, int w, int h);
+  void setAsset(const PackedAsset* newAsset);
+};
+
+// The widgets of one screen
+class WidgetScreen {
+private:
+  Widget* widgets[WIDGET_SCREEN_MAX];
+  uint8_t count;
+
+public:
+  WidgetScreen();
+  void add(Widget* widget);
+
+  // Redraw dirty widgets (or all of them after a screen switch);
+  // returns how many were re-rasterized
+  int draw(Adafruit_SSD1306* display, FastFont* font, bool full);
+};
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ * Mochi Robot - Test Checks
+ * PASS/FAIL bookkeeping shared by the test sketches
+ *
+ * Each sketch is its own program and includes this once, so the counter
+ * and helpers live here rather than in a separate translation unit.
+ */
+
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <Arduino.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char* name) {
+  Serial.print(ok ? "PASS " : "FAIL ");
+  Serial.println(name);
+  if (!ok) failures++;
+}
+
+// Last line of every run: "All tests passed" or "Failures: N"
+static void printTestSummary() {
+  Serial.print(failures == 0 ? "All tests passed" : "Failures: ");
+  if (failures > 0) Serial.print(failures);
+  Serial.println();
+}
+
+#endif
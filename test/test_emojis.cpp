@@ -66,8 +66,7 @@ void loop() {
   if (millis() - lastChange > 2000) {
     lastChange = millis();
     
-    emojiDrawer.updateAnimation();
-    emojiDrawer.drawEmoji(emojis[currentEmoji], millis() / 50);
+    emojiDrawer.drawEmoji(emojis[currentEmoji], millis());
     
     Serial.print("Showing emoji: ");
     Serial.println(currentEmoji);
@@ -75,8 +74,7 @@ void loop() {
     currentEmoji = (currentEmoji + 1) % (sizeof(emojis) / sizeof(emojis[0]));
   } else {
     // Update animation while waiting
-    emojiDrawer.updateAnimation();
-    emojiDrawer.drawEmoji(emojis[currentEmoji], millis() / 50);
+    emojiDrawer.drawEmoji(emojis[currentEmoji], millis());
   }
   
   delay(50);
@@ -0,0 +1,278 @@
+/*
+ * Mochi Robot - Eye Engine Test
+ * Checks easing curves, eye shapes, tracks and dirty-rect redraws, then
+ * benchmarks frames per second for typical eye animations
+ * Runs on the board, results are printed over Serial
+ */
+
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "eye_engine.h"
+#include "fb_primitives.h"
+#include "frame_governor.h"
+#include "test_check.h"
+
+#define BENCH_FRAMES 500
+#define FRAME_STEP_MS 20 // 50 fps timeline
+
+Adafruit_SSD1306 display(Panel::width, Panel::height, &Wire, -1);
+EyeEngine<Adafruit_SSD1306> eyes(display);
+
+bool lit(int x, int y) {
+  return display.getBuffer()[x + (y / 8) * Panel::width] & (1 << (y & 7));
+}
+
+uint32_t litPixels() {
+  return fbPopcount(display.getBuffer(), Panel::frameBytes);
+}
+
+// Centred eyes are mirror images of each other
+bool mirrored() {
+  for (int y = 0; y < Panel::height; y++) {
+    for (int x = 0; x < Panel::width / 2; x++) {
+      if (lit(x, y) != lit(Panel::width - 1 - x, y)) return false;
+    }
+  }
+  return true;
+}
+
+// Show a pose at once (no tween) and draw it from scratch
+void showPose(const EyePose& pose, unsigned long now) {
+  eyes.setPose(pose, 0);
+  eyes.invalidate();
+  eyes.drawFrame(now);
+}
+
+void testEasing() {
+  const EyeEasing curves[] = {EASE_LINEAR, EASE_IN, EASE_OUT, EASE_IN_OUT};
+  bool ends = true, monotonic = true;
+  for (EyeEasing easing : curves) {
+    if (eyeEase(easing, 0) != 0 || eyeEase(easing, EYE_EASE_ONE) != EYE_EASE_ONE) ends = false;
+    int32_t previous = 0;
+    for (int32_t t = 0; t <= EYE_EASE_ONE; t += 256) {
+      int32_t value = eyeEase(easing, t);
+      if (value < previous) monotonic = false;
+      previous = value;
+    }
+  }
+  check(ends, "easing curves start at 0 and end at 1");
+  check(monotonic, "easing curves never go back");
+
+  bool symmetric = true;
+  for (int32_t t = 0; t <= EYE_EASE_ONE; t += 256) {
+    int32_t sum = eyeEase(EASE_IN_OUT, t) + eyeEase(EASE_IN_OUT, EYE_EASE_ONE - t);
+    if (abs(sum - EYE_EASE_ONE) > 2) symmetric = false;
+  }
+  check(symmetric, "ease in-out is symmetric");
+}
+
+void testShapes() {
+  unsigned long now = millis();
+  showPose(eyeMoodPose(EYE_MOOD_DEFAULT), now);
+  uint32_t open = litPixels();
+  check(open > 0 && mirrored(), "default eyes are mirror images");
+
+  EyeRect left = eyeBounds(eyes.layoutFrame(eyes.evaluate(now), now).eyes[0]);
+  int innerX = left.x + left.w - 1 - EYE_RADIUS;
+  int outerX = left.x + EYE_RADIUS;
+  int topY = left.y + EYE_HEIGHT / 4; // Below the corner rounding
+
+  const EyeMood moods[] = {EYE_MOOD_TIRED, EYE_MOOD_ANGRY, EYE_MOOD_HAPPY};
+  bool symmetric = true, smaller = true;
+  for (EyeMood mood : moods) {
+    showPose(eyeMoodPose(mood), now);
+    if (!mirrored()) symmetric = false;
+    if (litPixels() >= open) smaller = false;
+  }
+  check(symmetric, "mood lids are mirrored too");
+  check(smaller, "mood lids cover part of the eye");
+
+  showPose(eyeMoodPose(EYE_MOOD_TIRED), now);
+  bool tired = !lit(outerX, topY) && lit(innerX, topY);
+  showPose(eyeMoodPose(EYE_MOOD_ANGRY), now);
+  bool angry = lit(outerX, topY) && !lit(innerX, topY);
+  check(tired, "tired lids cover the outer corner");
+  check(angry, "angry lids cover the inner corner");
+
+  EyePose shut = eyeMoodPose(EYE_MOOD_DEFAULT);
+  shut.openness = 0;
+  showPose(shut, now);
+  check(litPixels() > 0 && litPixels() <= (uint32_t)(2 * EYE_WIDTH), "shut eyes are a line");
+}
+
+void testTracks() {
+  unsigned long now = millis();
+  showPose(eyeMoodPose(EYE_MOOD_DEFAULT), now);
+  uint8_t openFrame[Panel::frameBytes];
+  memcpy(openFrame, display.getBuffer(), sizeof(openFrame));
+
+  eyes.playTrack(EYE_TRACK_BLINK, EYE_TRACK_BLINK_LENGTH, now);
+  eyes.drawFrame(now + 70);
+  bool closed = litPixels() <= (uint32_t)(2 * EYE_WIDTH);
+  eyes.drawFrame(now + 400);
+  check(closed, "blink shuts the eyes");
+  check(memcmp(openFrame, display.getBuffer(), sizeof(openFrame)) == 0, "eyes reopen after the blink");
+
+  eyes.playTrack(EYE_TRACK_LAUGH, EYE_TRACK_LAUGH_LENGTH, now + 400);
+  bool moved = false;
+  for (int t = 0; t <= 600; t += FRAME_STEP_MS) {
+    eyes.drawFrame(now + 400 + t);
+    if (memcmp(openFrame, display.getBuffer(), sizeof(openFrame)) != 0) moved = true;
+  }
+  check(moved && memcmp(openFrame, display.getBuffer(), sizeof(openFrame)) == 0, "laugh bounces and settles");
+
+  // Same inputs, same pixels
+  showPose(eyeMoodPose(EYE_MOOD_HAPPY), now);
+  uint8_t first[Panel::frameBytes];
+  memcpy(first, display.getBuffer(), sizeof(first));
+  showPose(eyeMoodPose(EYE_MOOD_HAPPY), now + 1000);
+  check(memcmp(first, display.getBuffer(), sizeof(first)) == 0, "frames are deterministic");
+}
+
+// Glances to the panel edges, squash, mood changes, a laugh and sweat;
+// with `contained` set, every changed pixel must lie in the dirty rect
+bool animate(unsigned long& t, bool checkContained) {
+  bool contained = true;
+  uint8_t before[Panel::frameBytes];
+  eyes.setSweat(true);
+  eyes.playTrack(EYE_TRACK_CONFUSED, EYE_TRACK_CONFUSED_LENGTH, t);
+  for (int i = 0; i < 100; i++) {
+    t += FRAME_STEP_MS;
+    if (i % 10 == 0) {
+      EyePose pose = eyeMoodPose((EyeMood)(i / 10 % 4));
+      pose.gazeX = (i % 20 == 0) ? EYE_Q8 : -EYE_Q8;
+      pose.gazeY = (i % 30 == 0) ? EYE_Q8 : -EYE_Q8 / 2;
+      pose.squash = (i % 40 == 0) ? EYE_MAX_SQUASH : -EYE_MAX_SQUASH;
+      eyes.setPose(pose, 150, EASE_IN_OUT, t);
+    }
+    if (i == 50) eyes.playTrack(EYE_TRACK_LAUGH, EYE_TRACK_LAUGH_LENGTH, t);
+    if (i == 70) eyes.setSweat(false);
+
+    memcpy(before, display.getBuffer(), sizeof(before));
+    eyes.drawFrame(t);
+    if (!checkContained) continue;
+    EyeRect dirty = eyes.getDirtyRect();
+    for (int y = 0; y < Panel::height; y++) {
+      for (int x = 0; x < Panel::width; x++) {
+        bool inside = x >= dirty.x && x < dirty.x + dirty.w && y >= dirty.y && y < dirty.y + dirty.h;
+        bool was = before[x + (y / 8) * Panel::width] & (1 << (y & 7));
+        if (!inside && was != lit(x, y)) contained = false;
+      }
+    }
+  }
+  return contained;
+}
+
+void testDirtyRects() {
+  unsigned long now = millis();
+  unsigned long t = now;
+
+  // Dots everywhere around the eyes: only dirty rects may touch them
+  showPose(eyeMoodPose(EYE_MOOD_DEFAULT), now);
+  for (int y = 0; y < Panel::height; y += 3) {
+    for (int x = 0; x < Panel::width; x += 3) {
+      if (!lit(x, y)) display.drawPixel(x, y, SSD1306_WHITE);
+    }
+  }
+  check(animate(t, true), "redraws stay inside the dirty rects");
+
+  // No trails: the incremental buffer equals a redraw from scratch
+  showPose(eyeMoodPose(EYE_MOOD_DEFAULT), t);
+  animate(t, false);
+  uint8_t incremental[Panel::frameBytes];
+  memcpy(incremental, display.getBuffer(), sizeof(incremental));
+  eyes.invalidate();
+  eyes.drawFrame(t);
+  check(memcmp(incremental, display.getBuffer(), sizeof(incremental)) == 0, "incremental frames leave no trails");
+
+  // A still pose redraws nothing
+  unsigned long skipped = eyes.getFramesSkipped();
+  eyes.drawFrame(t + 1000);
+  eyes.drawFrame(t + 1020);
+  check(eyes.getFramesSkipped() == skipped + 2 && eyes.getDirtyRect().w == 0, "unchanged frames are skipped");
+
+  // A small glance only touches the eyes
+  EyePose glance = eyes.getTargetPose();
+  glance.gazeX = EYE_Q8 / 8;
+  eyes.setPose(glance, 0, EASE_LINEAR, t + 1040);
+  eyes.drawFrame(t + 1040);
+  EyeRect dirty = eyes.getDirtyRect();
+  check(dirty.w > 0 && dirty.w * dirty.h < Panel::width * Panel::height, "glance dirties less than the panel");
+}
+
+// Render BENCH_FRAMES frames of one scenario and print the rate
+void benchScenario(const char* name, int scenario) {
+  unsigned long now = millis();
+  showPose(eyeMoodPose(EYE_MOOD_DEFAULT), now);
+
+  unsigned long worst = 0;
+  uint32_t cycles = 0;
+  unsigned long benchStart = micros();
+  for (int i = 0; i < BENCH_FRAMES; i++) {
+    now += FRAME_STEP_MS;
+    if (scenario == 1 && i % 15 == 0) {
+      EyePose pose = eyes.getTargetPose();
+      pose.gazeX = (i * 37) % 513 - EYE_Q8;
+      pose.gazeY = (i * 53) % 513 - EYE_Q8;
+      eyes.setPose(pose, EYE_GAZE_MS, EASE_IN_OUT, now);
+    }
+    if (scenario == 2 && i % 30 == 0) {
+      if (i % 60 == 0) {
+        eyes.playTrack(EYE_TRACK_BLINK, EYE_TRACK_BLINK_LENGTH, now);
+      } else {
+        eyes.playTrack(EYE_TRACK_LAUGH, EYE_TRACK_LAUGH_LENGTH, now);
+      }
+    }
+    if (scenario == 3) eyes.invalidate();
+
+    uint32_t startCycles = ESP.getCycleCount();
+    unsigned long start = micros();
+    eyes.drawFrame(now);
+    unsigned long spent = micros() - start;
+    cycles += ESP.getCycleCount() - startCycles;
+    if (spent > worst) worst = spent;
+  }
+  unsigned long total = micros() - benchStart;
+
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(cycles / BENCH_FRAMES);
+  Serial.print(" cycles/frame, ");
+  Serial.print(total > 0 ? (unsigned long)(1000000ULL * BENCH_FRAMES / total) : 0);
+  Serial.print(" fps, worst frame ");
+  Serial.print(worst);
+  Serial.println(" us");
+  check(worst * 4 <= 1000000UL / GOVERNOR_ACTIVE_FPS, "worst frame under a quarter of the frame budget");
+}
+
+void benchFrames() {
+  benchScenario("Still eyes", 0);
+  benchScenario("Glances", 1);
+  benchScenario("Blinks and laughs", 2);
+  benchScenario("Full redraw every frame", 3);
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+
+  Wire.begin(8, 9);
+  if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+    Serial.println(F("SSD1306 allocation failed"));
+    for(;;);
+  }
+
+  Serial.println("=== Eye Engine Test ===");
+  eyes.begin(GOVERNOR_ACTIVE_FPS);
+  testEasing();
+  testShapes();
+  testTracks();
+  testDirtyRects();
+  benchFrames();
+
+  printTestSummary();
+}
+
+void loop() {
+}
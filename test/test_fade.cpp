@@ -0,0 +1,175 @@
+/*
+ * Mochi Robot - Emotion Fade Test
+ * Checks the Bayer masks and a full cross-fade between two faces, then
+ * benchmarks the word-wide blend against a per-pixel GFX blend
+ * Runs on the board, results are printed over Serial
+ */
+
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "emoji_drawer.h"
+#include "emotion_fade.h"
+#include "fb_primitives.h"
+#include "frame_governor.h"
+#include "test_check.h"
+
+#define BENCH_ITERATIONS 500
+
+Adafruit_SSD1306 display(Panel::width, Panel::height, &Wire, -1);
+EmojiDrawer emojiDrawer(&display);
+EmotionFade fade;
+alignas(4) uint8_t faceA[Panel::frameBytes];
+alignas(4) uint8_t faceB[Panel::frameBytes];
+alignas(4) uint8_t frame[Panel::frameBytes];
+
+void renderFace(EmojiType type, uint8_t* out) {
+  emojiDrawer.renderEmoji(type, 0);
+  memcpy(out, display.getBuffer(), Panel::frameBytes);
+}
+
+void testMasks() {
+  bool counts = true, nested = true;
+  uint32_t previous[2] = {0, 0};
+  for (int level = 0; level <= FADE_LEVELS; level++) {
+    uint32_t mask[2];
+    EmotionFade::ditherMask(level, mask);
+    if (fbPopcount((const uint8_t*)mask, sizeof(mask)) != (uint32_t)level) counts = false;
+    if ((previous[0] & ~mask[0]) || (previous[1] & ~mask[1])) nested = false;
+    previous[0] = mask[0];
+    previous[1] = mask[1];
+  }
+  check(counts, "level n lights n of 64 pixels per tile");
+  check(nested, "each level keeps the pixels of the one before");
+
+  // Black to white at half level: exactly half the panel lit
+  memset(faceA, 0, sizeof(faceA));
+  memset(frame, 0xFF, sizeof(frame));
+  EmotionFade::blend(frame, faceA, FADE_LEVELS / 2);
+  check(fbPopcount(frame, sizeof(frame)) == Panel::frameBytes * 4, "half level is half the pixels");
+}
+
+void testCrossFade() {
+  emojiDrawer.setPosition(Panel::centerX, Panel::centerY);
+  emojiDrawer.setSize(Panel::layout(40, 24));
+  renderFace(EMOJI_HAPPY, faceA);
+  renderFace(EMOJI_SAD, faceB);
+
+  // Nothing to fade from until a frame was seen
+  fade.cancel();
+  fade.begin();
+  check(!fade.isActive(), "no fade before the first frame");
+
+  memcpy(frame, faceA, sizeof(frame));
+  fade.apply(frame);
+  check(memcmp(frame, faceA, sizeof(frame)) == 0, "frames pass through when idle");
+
+  fade.begin();
+  bool mixed = true, growing = true;
+  uint32_t lastMatch = 0;
+  int blended = 0;
+  while (fade.isActive()) {
+    memcpy(frame, faceB, sizeof(frame));
+    fade.apply(frame);
+    blended++;
+
+    // Every pixel comes from one face or the other, and more from B each frame
+    uint32_t match = 0;
+    for (int i = 0; i < Panel::frameBytes; i++) {
+      if ((frame[i] & ~(faceA[i] | faceB[i])) || (faceA[i] & faceB[i] & ~frame[i])) mixed = false;
+      uint8_t same = ~(frame[i] ^ faceB[i]);
+      while (same) { same &= same - 1; match++; }
+    }
+    if (match < lastMatch) growing = false;
+    lastMatch = match;
+  }
+  check(blended == EMOTION_FADE_FRAMES, "fade lasts EMOTION_FADE_FRAMES frames");
+  check(mixed, "blended pixels come from either face");
+  check(growing, "incoming face grows every frame");
+
+  memcpy(frame, faceB, sizeof(frame));
+  fade.apply(frame);
+  check(memcmp(frame, faceB, sizeof(frame)) == 0, "new face alone after the fade");
+
+  // Restart mid-fade: continues from what was on screen
+  fade.begin();
+  memcpy(frame, faceA, sizeof(frame));
+  fade.apply(frame);
+  uint8_t onScreen[Panel::frameBytes];
+  memcpy(onScreen, frame, sizeof(onScreen));
+  fade.begin();
+  memcpy(frame, faceB, sizeof(frame));
+  fade.apply(frame);
+  bool fromScreen = true;
+  for (int i = 0; i < Panel::frameBytes; i++) {
+    if (frame[i] & ~(onScreen[i] | faceB[i])) fromScreen = false;
+  }
+  check(fromScreen, "restart fades from the frame on screen");
+  fade.cancel();
+}
+
+// Reference: the same blend one pixel at a time through GFX
+void pixelBlend(const uint8_t* from, uint8_t level) {
+  uint32_t mask[2];
+  EmotionFade::ditherMask(level, mask);
+  const uint8_t* columns = (const uint8_t*)mask;
+  for (int y = 0; y < Panel::height; y++) {
+    for (int x = 0; x < Panel::width; x++) {
+      if (columns[x & 7] & (1 << (y & 7))) continue; // Incoming pixel stays
+      bool lit = from[x + (y / 8) * Panel::width] & (1 << (y & 7));
+      display.drawPixel(x, y, lit ? SSD1306_WHITE : SSD1306_BLACK);
+    }
+  }
+}
+
+void benchBlend() {
+  memcpy(frame, faceB, sizeof(frame));
+  uint32_t start = ESP.getCycleCount();
+  unsigned long startMicros = micros();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) {
+    EmotionFade::blend(frame, faceA, (i % FADE_LEVELS) + 1);
+  }
+  uint32_t wordCycles = (ESP.getCycleCount() - start) / BENCH_ITERATIONS;
+  unsigned long wordMicros = (micros() - startMicros) / BENCH_ITERATIONS;
+
+  memcpy(display.getBuffer(), faceB, Panel::frameBytes);
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) {
+    pixelBlend(faceA, (i % FADE_LEVELS) + 1);
+  }
+  uint32_t pixelCycles = (ESP.getCycleCount() - start) / BENCH_ITERATIONS;
+  check(memcmp(display.getBuffer(), frame, Panel::frameBytes) == 0, "word-wide blend matches per-pixel blend");
+
+  Serial.print("Blend (word-wide): ");
+  Serial.print(wordCycles);
+  Serial.print(" cycles, ");
+  Serial.print(wordMicros);
+  Serial.println(" us per frame");
+  Serial.print("Blend (GFX per pixel): ");
+  Serial.print(pixelCycles);
+  Serial.println(" cycles per frame");
+
+  // Well under the eye frame budget at the active rate
+  check(wordMicros * 100 <= 1000000UL / GOVERNOR_ACTIVE_FPS, "blend under 1% of an active frame");
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+
+  Wire.begin(8, 9);
+  if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+    Serial.println(F("SSD1306 allocation failed"));
+    for(;;);
+  }
+
+  Serial.println("=== Emotion Fade Test ===");
+  testMasks();
+  testCrossFade();
+  benchBlend();
+
+  printTestSummary();
+}
+
+void loop() {
+}
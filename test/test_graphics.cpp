@@ -0,0 +1,380 @@
+/*
+ * Mochi Robot - Graphics Golden Test
+ * Checks rasterizer output pixel-for-pixel against stored golden images
+ * and the framebuffer primitives against Adafruit GFX, plus the lit-pixel
+ * power limiter built on fbPopcount
+ * Runs on the board, results are printed over Serial
+ */
+
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "arc_raster.h"
+#include "fb_primitives.h"
+#include "display_brightness.h"
+#include "test_check.h"
+
+Adafruit_SSD1306 display(128, 64, &Wire, -1);
+
+// Golden arcs (thickness 2) as used by the emoji faces, centered in a
+// (2*radiusX+3) x (2*radiusY+3) canvas
+struct GoldenArc {
+  int radiusX, radiusY, startAngle, endAngle;
+  const char* rows[16];
+};
+
+const GoldenArc goldenArcs[] = {
+  { 12, 6, 0, 180, {
+    "...........................",
+    "...........................",
+    "...........................",
+    "...........................",
+    "...........................",
+    "...........................",
+    "...........................",
+    ".##.....................##.",
+    ".##.....................##.",
+    "..##...................##..",
+    "...###...............###...",
+    "....#####.........#####....",
+    "......###############......",
+    ".........#########.........",
+    "...........................",
+  } },
+  { 10, 5, 180, 360, {
+    ".......................",
+    ".......#########.......",
+    "....###############....",
+    "...####.........####...",
+    "..##...............##..",
+    ".##.................##.",
+    ".##.................##.",
+    ".......................",
+    ".......................",
+    ".......................",
+    ".......................",
+    ".......................",
+    ".......................",
+  } },
+  { 8, 3, 0, 180, {
+    "...................",
+    "...................",
+    "...................",
+    "...................",
+    ".##.............##.",
+    "..###.........###..",
+    "...#############...",
+    ".....#########.....",
+    "...................",
+  } },
+  { 8, 3, 180, 360, {
+    "...................",
+    ".....#########.....",
+    "...#############...",
+    "..###.........###..",
+    ".##.............##.",
+    "...................",
+    "...................",
+    "...................",
+    "...................",
+  } },
+  { 5, 2, 0, 180, {
+    ".............",
+    ".............",
+    ".............",
+    ".##.......##.",
+    "..#########..",
+    "...#######...",
+    ".............",
+  } },
+  { 4, 2, 0, 180, {
+    "...........",
+    "...........",
+    "...........",
+    ".##.....##.",
+    "..#######..",
+    "...#####...",
+    "...........",
+  } }
+};
+
+// The original step-sampled arc, kept to compare coverage
+void legacyArc(GFXcanvas1& canvas, int x, int y, int radiusX, int radiusY, int startAngle, int endAngle) {
+  int steps = abs(endAngle - startAngle) / 2;
+  if (steps < 1) steps = 1;
+  for (int i = 0; i <= steps; i++) {
+    int angle = startAngle + (endAngle - startAngle) * i / steps;
+    float rad = angle * PI / 180.0;
+    int px = x + radiusX * cos(rad);
+    int py = y + radiusY * sin(rad);
+    canvas.drawPixel(px, py, 1);
+    if (i > 0 && i < steps) {
+      canvas.drawPixel(px + 1, py, 1);
+      canvas.drawPixel(px, py + 1, 1);
+    }
+  }
+}
+
+bool canvasPixel(GFXcanvas1& canvas, int x, int y) {
+  if (x < 0 || y < 0 || x >= canvas.width() || y >= canvas.height()) return false;
+  return canvas.getPixel(x, y);
+}
+
+void testGoldenArcs() {
+  for (const GoldenArc& golden : goldenArcs) {
+    int w = 2 * golden.radiusX + 3;
+    int h = 2 * golden.radiusY + 3;
+    GFXcanvas1 canvas(w, h);
+    GFXcanvas1 legacy(w, h);
+    drawEllipseArc(&canvas, golden.radiusX + 1, golden.radiusY + 1, golden.radiusX, golden.radiusY,
+                   golden.startAngle, golden.endAngle, 2, 1);
+    legacyArc(legacy, golden.radiusX + 1, golden.radiusY + 1, golden.radiusX, golden.radiusY,
+              golden.startAngle, golden.endAngle);
+
+    bool exact = true;
+    bool covered = true;
+    for (int y = 0; y < h; y++) {
+      for (int x = 0; x < w; x++) {
+        bool expected = golden.rows[y][x] == '#';
+        if (canvasPixel(canvas, x, y) != expected) exact = false;
+
+        // Every pixel of the old output must stay within one pixel of the new arc
+        if (canvasPixel(legacy, x, y)) {
+          bool near = false;
+          for (int j = -1; j <= 1; j++) {
+            for (int i = -1; i <= 1; i++) {
+              if (canvasPixel(canvas, x + i, y + j)) near = true;
+            }
+          }
+          if (!near) covered = false;
+        }
+      }
+    }
+
+    char name[48];
+    snprintf(name, sizeof(name), "arc %dx%d %d-%d golden", golden.radiusX, golden.radiusY,
+             golden.startAngle, golden.endAngle);
+    check(exact, name);
+    snprintf(name, sizeof(name), "arc %dx%d %d-%d covers legacy", golden.radiusX, golden.radiusY,
+             golden.startAngle, golden.endAngle);
+    check(covered, name);
+  }
+}
+
+// Number of 8-connected pixel groups in the canvas
+int countComponents(GFXcanvas1& canvas) {
+  static int16_t stackX[1024], stackY[1024];
+  GFXcanvas1 visited(canvas.width(), canvas.height());
+  int components = 0;
+
+  for (int y = 0; y < canvas.height(); y++) {
+    for (int x = 0; x < canvas.width(); x++) {
+      if (!canvasPixel(canvas, x, y) || canvasPixel(visited, x, y)) continue;
+      components++;
+
+      int top = 0;
+      stackX[top] = x;
+      stackY[top++] = y;
+      visited.drawPixel(x, y, 1);
+      while (top > 0) {
+        top--;
+        int px = stackX[top];
+        int py = stackY[top];
+        for (int j = -1; j <= 1; j++) {
+          for (int i = -1; i <= 1; i++) {
+            int nx = px + i;
+            int ny = py + j;
+            if (canvasPixel(canvas, nx, ny) && !canvasPixel(visited, nx, ny) && top < 1024) {
+              visited.drawPixel(nx, ny, 1);
+              stackX[top] = nx;
+              stackY[top++] = ny;
+            }
+          }
+        }
+      }
+    }
+  }
+  return components;
+}
+
+void testNoGaps() {
+  // Full ellipses and arcs must form a single connected outline at every radius
+  bool ok = true;
+  for (int rx = 2; rx <= 60; rx += 7) {
+    for (int ry = 2; ry <= 30; ry += 5) {
+      GFXcanvas1 ellipse(2 * rx + 3, 2 * ry + 3);
+      drawEllipseArc(&ellipse, rx + 1, ry + 1, rx, ry, 0, 360, 1, 1);
+      if (countComponents(ellipse) != 1) ok = false;
+
+      GFXcanvas1 arc(2 * rx + 3, 2 * ry + 3);
+      drawEllipseArc(&arc, rx + 1, ry + 1, rx, ry, 20, 250, 1, 1);
+      if (countComponents(arc) != 1) ok = false;
+    }
+  }
+  check(ok, "ellipses have no gaps");
+}
+
+// Deterministic shape parameters
+uint32_t testSeed = 12345;
+int nextRandom(int low, int high) {
+  testSeed = testSeed * 1103515245UL + 12345UL;
+  return low + (int)((testSeed >> 16) % (uint32_t)(high - low + 1));
+}
+
+// Striped background so BLACK and INVERSE have something to clear
+void fillPattern() {
+  uint8_t* buffer = display.getBuffer();
+  for (int i = 0; i < 128 * 8; i++) buffer[i] = (uint8_t)(0xA5 ^ i);
+}
+
+uint8_t reference[128 * 8];
+
+// Draw with GFX, then with the primitive, on the same background
+#define EXPECT_SAME(gfxCall, fbCall, ok) do { \
+    fillPattern(); gfxCall; memcpy(reference, display.getBuffer(), sizeof(reference)); \
+    fillPattern(); fbCall; \
+    if (memcmp(reference, display.getBuffer(), sizeof(reference)) != 0) ok = false; \
+  } while (0)
+
+void testPrimitives() {
+  const uint16_t colors[] = { SSD1306_WHITE, SSD1306_BLACK, SSD1306_INVERSE };
+  bool rects = true, hlines = true, vlines = true, circles = true;
+
+  for (int i = 0; i < 300; i++) {
+    uint16_t color = colors[i % 3];
+    int x = nextRandom(-20, 140);
+    int y = nextRandom(-20, 80);
+    int w = nextRandom(0, 100);
+    int h = nextRandom(0, 70);
+    EXPECT_SAME(display.fillRect(x, y, w, h, color), fbFillRect(&display, x, y, w, h, color), rects);
+    EXPECT_SAME(display.drawFastHLine(x, y, w, color), fbDrawHLine(&display, x, y, w, color), hlines);
+    EXPECT_SAME(display.drawFastVLine(x, y, h, color), fbDrawVLine(&display, x, y, h, color), vlines);
+  }
+
+  // GFX overlaps circle columns, so only WHITE and BLACK match it exactly
+  for (int r = 0; r <= 40; r++) {
+    int x = nextRandom(-10, 138);
+    int y = nextRandom(-10, 74);
+    EXPECT_SAME(display.fillCircle(x, y, r, SSD1306_WHITE), fbFillCircle(&display, x, y, r, SSD1306_WHITE), circles);
+    EXPECT_SAME(display.fillCircle(x, y, r, SSD1306_BLACK), fbFillCircle(&display, x, y, r, SSD1306_BLACK), circles);
+  }
+
+  check(rects, "fbFillRect matches fillRect");
+  check(hlines, "fbDrawHLine matches drawFastHLine");
+  check(vlines, "fbDrawVLine matches drawFastVLine");
+  check(circles, "fbFillCircle matches fillCircle");
+}
+
+void testBlitAndPopcount() {
+  uint8_t sprite[3 * 21];
+  for (int i = 0; i < (int)sizeof(sprite); i++) sprite[i] = (uint8_t)nextRandom(0, 255);
+
+  bool blits = true;
+  for (int i = 0; i < 50; i++) {
+    int x = nextRandom(-25, 130);
+    int page = nextRandom(-3, 8);
+    bool exclusive = i & 1;
+
+    // Reference: one pixel at a time
+    fillPattern();
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 21; col++) {
+        for (int bit = 0; bit < 8; bit++) {
+          if (sprite[row * 21 + col] & (1 << bit)) {
+            display.drawPixel(x + col, (page + row) * 8 + bit, exclusive ? SSD1306_INVERSE : SSD1306_WHITE);
+          }
+        }
+      }
+    }
+    memcpy(reference, display.getBuffer(), sizeof(reference));
+
+    fillPattern();
+    if (exclusive) {
+      fbBlitXor(&display, sprite, 21, 3, x, page);
+    } else {
+      fbBlitOr(&display, sprite, 21, 3, x, page);
+    }
+    if (memcmp(reference, display.getBuffer(), sizeof(reference)) != 0) blits = false;
+  }
+  check(blits, "fbBlitOr/fbBlitXor match drawPixel");
+
+  // Odd offsets and lengths exercise the unaligned head and tail
+  bool counts = true;
+  fillPattern();
+  for (int start = 0; start < 8; start++) {
+    for (int length = 0; length < 300; length += 37) {
+      uint32_t expected = 0;
+      for (int i = start; i < start + length; i++) {
+        for (int bit = 0; bit < 8; bit++) {
+          if (display.getBuffer()[i] & (1 << bit)) expected++;
+        }
+      }
+      if (fbPopcount(display.getBuffer() + start, length) != expected) counts = false;
+    }
+  }
+  check(counts, "fbPopcount matches bit loop");
+}
+
+void trackFrames(DisplayBrightness& brightness, int frames) {
+  for (int i = 0; i < frames; i++) brightness.trackFrame(display.getBuffer(), 128 * 64 / 8);
+}
+
+void testPowerLimiter() {
+  DisplayBrightness brightness(&display);
+  brightness.setCurrentBudget(10);
+
+  // Two eyes: well under budget
+  display.clearDisplay();
+  display.fillRect(20, 16, 30, 30, SSD1306_WHITE);
+  display.fillRect(78, 16, 30, 30, SSD1306_WHITE);
+  trackFrames(brightness, 40);
+  check(!brightness.isPowerLimited() && brightness.getAppliedContrast() == 255, "eyes keep full contrast");
+
+  // One bright frame barely moves the average
+  display.fillRect(0, 0, 128, 64, SSD1306_WHITE);
+  trackFrames(brightness, 1);
+  check(brightness.getAppliedContrast() == 255, "single full frame is averaged out");
+
+  // Sustained full-white frame: contrast capped to the budget
+  trackFrames(brightness, 40);
+  Serial.print("Full frame: ");
+  Serial.print(brightness.getEstimatedMicroamps());
+  Serial.print(" uA at contrast ");
+  Serial.println(brightness.getAppliedContrast());
+  check(brightness.isPowerLimited() && brightness.getEstimatedMicroamps() <= 10000,
+        "full frame kept under the budget");
+
+  // Sparse again: contrast comes back
+  display.clearDisplay();
+  display.fillRect(20, 16, 30, 30, SSD1306_WHITE);
+  trackFrames(brightness, 60);
+  check(brightness.getAppliedContrast() == 255, "contrast restored for sparse frames");
+
+  brightness.setCurrentBudget(0);
+  display.fillRect(0, 0, 128, 64, SSD1306_WHITE);
+  trackFrames(brightness, 40);
+  check(!brightness.isPowerLimited(), "budget 0 disables the limiter");
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+
+  Wire.begin(8, 9);
+  if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+    Serial.println(F("SSD1306 allocation failed"));
+    for(;;);
+  }
+
+  Serial.println("=== Graphics Golden Test ===");
+  testGoldenArcs();
+  testNoGaps();
+  testPrimitives();
+  testBlitAndPopcount();
+  testPowerLimiter();
+
+  printTestSummary();
+}
+
+void loop() {
+}
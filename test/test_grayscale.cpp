@@ -0,0 +1,168 @@
+/*
+ * Mochi Robot - Grayscale Test
+ * Builds soft-edged gray planes for every emoji face, checks the levels
+ * and that cycling the subframes stays inside the I2C bus budget
+ * (diff flush cost per subframe at FLUSH_I2C_HZ vs GRAY_SUBFRAME_MS)
+ * Runs on the board, results are printed over Serial
+ */
+
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "emoji_drawer.h"
+#include "grayscale.h"
+#include "display_flush.h"
+#include "test_check.h"
+
+Adafruit_SSD1306 display(Panel::width, Panel::height, &Wire, -1);
+EmojiDrawer emojiDrawer(&display);
+Grayscale grayscale;
+uint8_t shown[Panel::frameBytes]; // What the simulated panel shows
+
+bool lit(const uint8_t* frame, int x, int y) {
+  return frame[x + (y / 8) * Panel::width] & (1 << (y & 7));
+}
+
+// Level 3 on lit pixels, 1 on their unlit 4-neighbours, 0 elsewhere
+bool levelsMatch(const uint8_t* frame) {
+  for (int y = 0; y < Panel::height; y++) {
+    for (int x = 0; x < Panel::width; x++) {
+      uint8_t expected = 0;
+      if (lit(frame, x, y)) {
+        expected = 3;
+      } else if ((x > 0 && lit(frame, x - 1, y)) || (x < Panel::width - 1 && lit(frame, x + 1, y)) ||
+                 (y > 0 && lit(frame, x, y - 1)) || (y < Panel::height - 1 && lit(frame, x, y + 1))) {
+        expected = 1;
+      }
+      if (grayscale.getLevel(x, y) != expected) return false;
+    }
+  }
+  return true;
+}
+
+// Each pixel is lit in exactly `level` of the subframes
+bool dutyMatchesLevels() {
+  uint8_t counts[Panel::frameBytes][8];
+  memset(counts, 0, sizeof(counts));
+  for (int s = 0; s < GRAY_SUBFRAMES; s++) {
+    const uint8_t* sub = grayscale.getSubframe(s);
+    for (int i = 0; i < Panel::frameBytes; i++) {
+      for (int bit = 0; bit < 8; bit++) {
+        if (sub[i] & (1 << bit)) counts[i][bit]++;
+      }
+    }
+  }
+  for (int y = 0; y < Panel::height; y++) {
+    for (int x = 0; x < Panel::width; x++) {
+      if (counts[x + (y / 8) * Panel::width][y & 7] != grayscale.getLevel(x, y)) return false;
+    }
+  }
+  return true;
+}
+
+// Pages without gray pixels are identical in every subframe
+bool plainPagesStatic() {
+  uint8_t first[Panel::frameBytes];
+  memcpy(first, grayscale.getSubframe(0), sizeof(first));
+  for (int s = 1; s < GRAY_SUBFRAMES; s++) {
+    const uint8_t* sub = grayscale.getSubframe(s);
+    for (int page = 0; page < Panel::pages; page++) {
+      if (grayscale.getGrayPages() & (1 << page)) continue;
+      if (memcmp(first + page * Panel::width, sub + page * Panel::width, Panel::width) != 0) return false;
+    }
+  }
+  return true;
+}
+
+// Worst subframe of two full gray cycles, as the flush task would send them
+unsigned long worstSubframeMicros(const uint8_t* frame) {
+  memcpy(shown, frame, sizeof(shown)); // The plain frame was flushed first
+  unsigned long worst = 0;
+  for (int i = 0; i < 2 * GRAY_SUBFRAMES; i++) {
+    const uint8_t* next = grayscale.nextSubframe();
+    unsigned long micros = DisplayFlush::busMicros(DisplayFlush::wireBytes(shown, next));
+    if (micros > worst) worst = micros;
+    memcpy(shown, next, sizeof(shown));
+  }
+  return worst;
+}
+
+void testFaces() {
+  static const uint8_t blank[Panel::frameBytes] = {0};
+  emojiDrawer.setPosition(Panel::centerX, Panel::centerY);
+  emojiDrawer.setSize(Panel::layout(40, 24));
+
+  bool levels = true, duty = true, pages = true, plain = true;
+  unsigned long worst = 0;
+  unsigned long fullFrame = 0;
+  for (int type = 0; type <= EMOJI_NEUTRAL; type++) {
+    emojiDrawer.renderEmoji((EmojiType)type, 0);
+    const uint8_t* frame = display.getBuffer();
+    grayscale.smoothEdges(frame);
+
+    if (!levelsMatch(frame)) levels = false;
+    if (!dutyMatchesLevels()) duty = false;
+    if (!plainPagesStatic()) pages = false;
+    if (memcmp(grayscale.getSubframe(GRAY_PLAIN_SUBFRAME), frame, Panel::frameBytes) != 0) plain = false;
+
+    unsigned long micros = worstSubframeMicros(frame);
+    if (micros > worst) worst = micros;
+    unsigned long full = DisplayFlush::busMicros(DisplayFlush::wireBytes(blank, frame));
+    if (full > fullFrame) fullFrame = full;
+  }
+  check(levels, "edges get level 1, lit pixels level 3");
+  check(duty, "subframe duty matches the gray level");
+  check(pages, "pages without gray never change");
+  check(plain, "plain subframe is the 1bpp frame");
+
+  Serial.print("Worst subframe: ");
+  Serial.print(worst);
+  Serial.print(" us of ");
+  Serial.print(GRAY_SUBFRAME_MS * 1000);
+  Serial.print(" us (full face frame: ");
+  Serial.print(fullFrame);
+  Serial.println(" us)");
+  check(worst <= GRAY_SUBFRAME_MS * 1000UL, "subframes fit the bus budget");
+}
+
+void testFlatFrames() {
+  // Nothing lit or everything lit: no gray, nothing to cycle
+  display.clearDisplay();
+  grayscale.smoothEdges(display.getBuffer());
+  check(!grayscale.hasGray(), "blank frame has no gray");
+  display.fillRect(0, 0, Panel::width, Panel::height, SSD1306_WHITE);
+  grayscale.smoothEdges(display.getBuffer());
+  check(!grayscale.hasGray(), "full frame has no gray");
+
+  // Explicit planes: a 4-step ramp
+  uint8_t high[Panel::frameBytes] = {0};
+  uint8_t low[Panel::frameBytes] = {0};
+  for (int x = 0; x < Panel::width; x++) {
+    uint8_t level = x * 4 / Panel::width;
+    high[x] = (level & 2) ? 0xFF : 0;
+    low[x] = (level & 1) ? 0xFF : 0;
+  }
+  grayscale.setPlanes(high, low);
+  check(grayscale.getLevel(0, 0) == 0 && grayscale.getLevel(Panel::width - 1, 7) == 3, "ramp ends");
+  check(dutyMatchesLevels() && grayscale.getGrayPages() == 1, "ramp only cycles its own page");
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+
+  Wire.begin(8, 9);
+  if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+    Serial.println(F("SSD1306 allocation failed"));
+    for(;;);
+  }
+
+  Serial.println("=== Grayscale Test ===");
+  testFaces();
+  testFlatFrames();
+
+  printTestSummary();
+}
+
+void loop() {
+}
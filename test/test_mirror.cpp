@@ -0,0 +1,140 @@
+/*
+ * Mochi Robot - Frame Mirror Test
+ * Encodes typical frame sequences, decodes them the way the viewer does
+ * and prints the bytes each packet costs
+ * Runs on the board, results are printed over Serial
+ */
+
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "frame_mirror.h"
+#include "test_check.h"
+
+Adafruit_SSD1306 display(Panel::width, Panel::height, &Wire, -1);
+FrameMirror mirror;
+uint8_t viewer[Panel::frameBytes]; // What the decoder has rebuilt
+
+// Viewer side: PackBits-decode the payload and XOR it into the frame
+bool applyPacket(const uint8_t* packet, size_t length) {
+  if (length < MIRROR_HEADER_BYTES || packet[0] != 'M' || packet[1] != 'F') return false;
+  if (packet[4] != Panel::width || packet[5] != Panel::height) return false;
+  size_t payload = packet[6] | (packet[7] << 8);
+  if (payload + MIRROR_HEADER_BYTES != length) return false;
+  if (packet[2] & MIRROR_FLAG_KEYFRAME) memset(viewer, 0, sizeof(viewer));
+
+  const uint8_t* src = packet + MIRROR_HEADER_BYTES;
+  const uint8_t* end = src + payload;
+  size_t index = 0;
+  while (src < end) {
+    uint8_t n = *src++;
+    if (n < 128) {
+      for (int i = 0; i <= n; i++) {
+        if (index >= sizeof(viewer)) return false;
+        viewer[index++] ^= *src++;
+      }
+    } else if (n > 128) {
+      uint8_t bits = *src++;
+      for (int i = 0; i < 257 - n; i++) {
+        if (index >= sizeof(viewer)) return false;
+        viewer[index++] ^= bits;
+      }
+    }
+  }
+  return index == sizeof(viewer);
+}
+
+size_t sendFrame(const char* name) {
+  mirror.capture(display.getBuffer());
+  size_t length = mirror.encodePacket();
+  bool ok = applyPacket(mirror.getPacket(), length) &&
+            memcmp(viewer, display.getBuffer(), sizeof(viewer)) == 0;
+  check(ok, name);
+  Serial.print("  ");
+  Serial.print(length);
+  Serial.println(" bytes");
+  return length;
+}
+
+void drawEyes(int height) {
+  display.clearDisplay();
+  display.fillRoundRect(Panel::centerX - 44, Panel::centerY - height / 2, 36, height, 8, SSD1306_WHITE);
+  display.fillRoundRect(Panel::centerX + 8, Panel::centerY - height / 2, 36, height, 8, SSD1306_WHITE);
+}
+
+void testPackBits() {
+  // Random data with runs: encode, then decode and compare
+  uint8_t data[300];
+  uint8_t packed[300 + 300 / 128 + 1];
+  bool ok = true;
+  for (int round = 0; round < 20; round++) {
+    for (int i = 0; i < (int)sizeof(data); i++) {
+      data[i] = (random(4) == 0) ? random(256) : (i > 0 ? data[i - 1] : 0);
+    }
+    size_t length = packBits(data, sizeof(data), packed);
+    if (length > sizeof(packed)) ok = false;
+
+    uint8_t decoded[sizeof(data)];
+    size_t in = 0, out = 0;
+    while (in < length && out <= sizeof(data)) {
+      uint8_t n = packed[in++];
+      if (n < 128) {
+        for (int i = 0; i <= n && out < sizeof(data); i++) decoded[out++] = packed[in++];
+      } else if (n > 128) {
+        for (int i = 0; i < 257 - n && out < sizeof(data); i++) decoded[out++] = packed[in];
+        in++;
+      }
+    }
+    if (out != sizeof(data) || memcmp(decoded, data, sizeof(data)) != 0) ok = false;
+  }
+  check(ok, "packBits round trip");
+}
+
+void testStream() {
+  // First packet to a viewer is a keyframe against a blank frame
+  mirror.resetReference();
+  drawEyes(Panel::layout(36, 20));
+  sendFrame("keyframe rebuilds the eyes");
+
+  size_t still = sendFrame("unchanged frame");
+  check(still <= MIRROR_HEADER_BYTES + 2 * (Panel::frameBytes / 128 + 1), "unchanged frame is only zero runs");
+
+  drawEyes(Panel::layout(8, 4));
+  size_t blink = sendFrame("blink");
+
+  display.clearDisplay();
+  display.setTextSize(2);
+  display.setTextColor(SSD1306_WHITE);
+  display.setCursor(16, Panel::centerY - 8);
+  display.print("12:34:56");
+  sendFrame("clock");
+  display.fillRect(88, Panel::centerY - 8, 24, 16, SSD1306_BLACK);
+  display.setCursor(88, Panel::centerY - 8);
+  display.print("57");
+  size_t tick = sendFrame("clock tick");
+  check(tick < blink, "a clock tick costs less than a blink");
+
+  for (int i = 0; i < (int)Panel::frameBytes; i++) display.getBuffer()[i] = random(256);
+  size_t noise = sendFrame("full-screen noise");
+  check(noise <= MIRROR_HEADER_BYTES + MIRROR_MAX_PAYLOAD, "worst case fits the packet buffer");
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+
+  Wire.begin(8, 9);
+  if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+    Serial.println(F("SSD1306 allocation failed"));
+    for(;;);
+  }
+
+  Serial.println("=== Frame Mirror Test ===");
+  testPackBits();
+  testStream();
+
+  printTestSummary();
+}
+
+void loop() {
+}
@@ -0,0 +1,207 @@
+/*
+ * Mochi Robot - Particle System Test
+ * Checks particle motion, rasterization against GFX and the CPU budget,
+ * then benchmarks 64, 256 and 1024 particles per style
+ * Runs on the board, results are printed over Serial
+ */
+
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "particle_system.h"
+#include "weather_condition.h"
+#include "compositor.h"
+#include "test_check.h"
+
+#define BENCH_CAPACITY 1024
+#define BENCH_FRAMES 400
+
+Adafruit_SSD1306 display(Panel::width, Panel::height, &Wire, -1);
+Layer reference(Panel::width, Panel::height);
+ParticleSystem particles(BENCH_CAPACITY);
+
+const WeatherCondition SCENES[] = {
+  WEATHER_FEW_CLOUDS, WEATHER_CLOUDS, WEATHER_DRIZZLE, WEATHER_RAIN,
+  WEATHER_THUNDERSTORM, WEATHER_SNOW, WEATHER_MIST
+};
+
+// The same particles drawn one GFX call at a time
+void referenceRender() {
+  reference.clearDisplay();
+  const int16_t* x = particles.getX();
+  const int16_t* y = particles.getY();
+  const uint8_t* sizes = particles.getSizes();
+  for (int i = 0; i < particles.getCount(); i++) {
+    int px = x[i] >> PARTICLE_FRAC_BITS;
+    int py = y[i] >> PARTICLE_FRAC_BITS;
+    switch (particles.getEmitter().style) {
+      case PARTICLE_DOT:
+        reference.drawPixel(px, py, SSD1306_WHITE);
+        break;
+      case PARTICLE_STREAK:
+        reference.drawFastVLine(px, py, sizes[i], SSD1306_WHITE);
+        break;
+      case PARTICLE_PUFF:
+        reference.drawFastHLine(px, py, sizes[i], SSD1306_WHITE);
+        reference.drawFastHLine(px + sizes[i] / 4, py - 1, sizes[i] / 2, SSD1306_WHITE);
+        break;
+      case PARTICLE_BAND:
+        reference.drawFastHLine(px, py, sizes[i], SSD1306_WHITE);
+        break;
+    }
+  }
+}
+
+void testScenes() {
+  bool still = !weatherConditionEmitter(WEATHER_CLEAR).count && !weatherConditionEmitter(WEATHER_UNKNOWN).count;
+  check(still, "clear sky and no data have no particles");
+
+  bool counts = true, moving = true, inside = true, matches = true;
+  for (WeatherCondition condition : SCENES) {
+    const ParticleEmitter& emitter = weatherConditionEmitter(condition);
+    particles.setSeed(1234);
+    particles.setEmitter(emitter);
+    if (particles.getCount() != emitter.count || !particles.isAnimated()) counts = false;
+
+    for (int frame = 0; frame < 200; frame++) {
+      int16_t before[BENCH_CAPACITY];
+      memcpy(before, emitter.vyMax > 0 ? particles.getY() : particles.getX(), particles.getCount() * sizeof(int16_t));
+      particles.step();
+
+      const int16_t* x = particles.getX();
+      const int16_t* y = particles.getY();
+      const int16_t* axis = emitter.vyMax > 0 ? y : x;
+      for (int i = 0; i < particles.getCount(); i++) {
+        int margin = particles.getSizes()[i] << PARTICLE_FRAC_BITS;
+        // Falling ones only go down, drifting ones only right; respawns start off-panel
+        if (axis[i] <= before[i] && axis[i] >= 0) moving = false;
+        if (x[i] < -margin || x[i] >= (Panel::width << PARTICLE_FRAC_BITS)) inside = false;
+        if (y[i] < -margin || y[i] >= (Panel::height << PARTICLE_FRAC_BITS)) inside = false;
+      }
+
+      display.clearDisplay();
+      particles.render(&display);
+      referenceRender();
+      if (memcmp(display.getBuffer(), reference.getBuffer(), Panel::frameBytes) != 0) matches = false;
+    }
+  }
+  check(counts, "every scene spawns its emitter count");
+  check(moving, "particles fall or drift every step");
+  check(inside, "particles stay on or just off the panel");
+  check(matches, "render matches GFX pixel for pixel");
+
+  // Same seed, same scene
+  particles.setSeed(99);
+  particles.setEmitter(weatherConditionEmitter(WEATHER_SNOW));
+  for (int i = 0; i < 50; i++) particles.step();
+  display.clearDisplay();
+  particles.render(&display);
+  uint8_t first[Panel::frameBytes];
+  memcpy(first, display.getBuffer(), sizeof(first));
+  particles.setSeed(99);
+  particles.setEmitter(weatherConditionEmitter(WEATHER_SNOW));
+  for (int i = 0; i < 50; i++) particles.step();
+  display.clearDisplay();
+  particles.render(&display);
+  check(memcmp(first, display.getBuffer(), sizeof(first)) == 0, "same seed plays the same scene");
+}
+
+void testBudget() {
+  ParticleEmitter rain = weatherConditionEmitter(WEATHER_RAIN);
+  rain.count = BENCH_CAPACITY;
+
+  // Plenty of time: everything stays
+  particles.setBudgetMicros(1000000);
+  particles.setEmitter(rain);
+  for (int i = 0; i < 20; i++) particles.frame(&display);
+  check(particles.getCount() == BENCH_CAPACITY, "generous budget keeps all particles");
+
+  // A quarter of what the full count costs: trimmed to fit, then settles
+  unsigned long fullMicros = (unsigned long)particles.getCostNanos() * BENCH_CAPACITY / 1000;
+  particles.setBudgetMicros(fullMicros / 4 > 0 ? fullMicros / 4 : 1);
+  for (int i = 0; i < 50; i++) particles.frame(&display);
+  check(particles.getCount() < BENCH_CAPACITY && particles.getCount() >= PARTICLE_MIN_COUNT,
+        "tight budget trims the live count");
+  uint32_t predicted = (uint32_t)particles.getCostNanos() * particles.getCount() / 1000;
+  check(predicted <= particles.getBudgetMicros() + 1, "trimmed count fits the budget");
+
+  // Budget back: grows again a few particles per frame
+  particles.setBudgetMicros(1000000);
+  uint16_t trimmed = particles.getCount();
+  particles.frame(&display);
+  check(particles.getCount() > trimmed && particles.getCount() <= trimmed + PARTICLE_MIN_COUNT,
+        "count grows back gradually");
+  particles.setBudgetMicros(PARTICLE_BUDGET_MICROS);
+}
+
+// Cost of step() + render() for `count` particles of one style, ns per particle
+uint32_t benchStyle(ParticleStyle style, uint16_t count) {
+  const ParticleEmitter& base = weatherConditionEmitter(style == PARTICLE_DOT ? WEATHER_SNOW :
+                                                       style == PARTICLE_STREAK ? WEATHER_RAIN :
+                                                       style == PARTICLE_PUFF ? WEATHER_CLOUDS : WEATHER_MIST);
+  ParticleEmitter emitter = base;
+  emitter.count = count;
+  particles.setSeed(7);
+  particles.setEmitter(emitter);
+
+  // OR costs the same whatever is already lit, so the buffer is not cleared
+  display.clearDisplay();
+  uint32_t start = ESP.getCycleCount();
+  unsigned long startMicros = micros();
+  for (int i = 0; i < BENCH_FRAMES; i++) {
+    particles.step();
+    particles.render(&display);
+  }
+  unsigned long totalMicros = micros() - startMicros;
+  uint32_t cycles = (ESP.getCycleCount() - start) / BENCH_FRAMES;
+  uint32_t nanos = (uint32_t)((uint64_t)totalMicros * 1000 / ((uint32_t)BENCH_FRAMES * count));
+
+  Serial.print("  ");
+  Serial.print(count);
+  Serial.print(" particles: ");
+  Serial.print(cycles);
+  Serial.print(" cycles, ");
+  Serial.print((float)totalMicros / BENCH_FRAMES, 1);
+  Serial.print(" us per frame, ");
+  Serial.print(nanos);
+  Serial.println(" ns per particle");
+  return nanos;
+}
+
+void benchParticles() {
+  const char* names[] = {"Dots (snow)", "Streaks (rain)", "Puffs (clouds)", "Bands (mist)"};
+  bool linear = true;
+  unsigned long worst256 = 0;
+  for (int style = PARTICLE_DOT; style <= PARTICLE_BAND; style++) {
+    Serial.println(names[style]);
+    benchStyle((ParticleStyle)style, 64);
+    uint32_t at256 = benchStyle((ParticleStyle)style, 256);
+    uint32_t at1024 = benchStyle((ParticleStyle)style, 1024);
+    // Linear: the per-particle cost does not grow with the count
+    if (at1024 > at256 * 2 + 10) linear = false;
+    if (at256 * 256 / 1000 > worst256) worst256 = at256 * 256 / 1000;
+  }
+  check(linear, "cost per particle flat from 256 to 1024");
+  check(worst256 <= PARTICLE_BUDGET_MICROS, "256 particles fit the default budget");
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+
+  Wire.begin(8, 9);
+  if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+    Serial.println(F("SSD1306 allocation failed"));
+    for(;;);
+  }
+
+  Serial.println("=== Particle System Test ===");
+  testScenes();
+  testBudget();
+  benchParticles();
+
+  printTestSummary();
+}
+
+void loop() {
+}
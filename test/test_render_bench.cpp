@@ -0,0 +1,223 @@
+/*
+ * Mochi Robot - Rendering Benchmark
+ * Measures CPU cycles spent rendering into the framebuffer (no I2C)
+ * Runs on the board (ESP.getCycleCount), results are printed over Serial
+ */
+
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "emoji_drawer.h"
+#include "fixed_trig.h"
+#include "sprite_cache.h"
+#include "assets_generated.h"
+#include "fast_font.h"
+#include "fb_primitives.h"
+
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+#define OLED_RESET    -1
+#define SCREEN_ADDRESS 0x3C
+
+#define BENCH_ITERATIONS 200
+
+Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+EmojiDrawer emojiDrawer(&display);
+SpriteCache spriteCache(4096);
+FastFont fastFont(&display);
+
+// Reference: the original soft-float arc loop
+void floatArc(int x, int y, int radiusX, int radiusY, int startAngle, int endAngle) {
+  int steps = abs(endAngle - startAngle) / 2;
+  if (steps < 1) steps = 1;
+  for (int i = 0; i <= steps; i++) {
+    int angle = startAngle + (endAngle - startAngle) * i / steps;
+    float rad = angle * PI / 180.0;
+    display.drawPixel(x + radiusX * cos(rad), y + radiusY * sin(rad), SSD1306_WHITE);
+  }
+}
+
+// Same loop with the Q15 lookup table
+void fixedArc(int x, int y, int radiusX, int radiusY, int startAngle, int endAngle) {
+  int steps = abs(endAngle - startAngle) / 2;
+  if (steps < 1) steps = 1;
+  for (int i = 0; i <= steps; i++) {
+    int angle = startAngle + (endAngle - startAngle) * i / steps;
+    display.drawPixel(x + fixedMulQ15(radiusX, fixedCos(angle)),
+                      y + fixedMulQ15(radiusY, fixedSin(angle)), SSD1306_WHITE);
+  }
+}
+
+void printResult(const char* name, uint32_t cycles) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(cycles / BENCH_ITERATIONS);
+  Serial.println(" cycles");
+}
+
+void benchArcs() {
+  uint32_t start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) floatArc(64, 40, 12, 6, 0, 180);
+  printResult("Arc (float sin/cos)", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) fixedArc(64, 40, 12, 6, 0, 180);
+  printResult("Arc (Q15 table)", ESP.getCycleCount() - start);
+}
+
+void benchEmojis() {
+  uint32_t total = 0;
+  for (int type = 0; type <= EMOJI_NEUTRAL; type++) {
+    uint32_t start = ESP.getCycleCount();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+      emojiDrawer.renderEmoji((EmojiType)type, i * ANIM_TICK_MS);
+    }
+    total += ESP.getCycleCount() - start;
+  }
+  printResult("Emoji frame (average of all faces)", total / (EMOJI_NEUTRAL + 1));
+}
+
+void benchSpriteCache() {
+  emojiDrawer.setSpriteCache(&spriteCache);
+  uint32_t total = 0;
+  for (int type = 0; type <= EMOJI_NEUTRAL; type++) {
+    uint32_t start = ESP.getCycleCount();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+      emojiDrawer.renderEmoji((EmojiType)type, i * ANIM_TICK_MS);
+    }
+    total += ESP.getCycleCount() - start;
+  }
+  emojiDrawer.setSpriteCache(nullptr);
+  printResult("Emoji frame (sprite cache)", total / (EMOJI_NEUTRAL + 1));
+
+  Serial.print("Cache hits/misses/evictions: ");
+  Serial.print(spriteCache.getHits());
+  Serial.print("/");
+  Serial.print(spriteCache.getMisses());
+  Serial.print("/");
+  Serial.println(spriteCache.getEvictions());
+}
+
+// Reference: the procedural WiFi icon the asset replaced
+void proceduralWiFiIcon() {
+  for (int radius = 5; radius >= 3; radius -= 2) {
+    for (int i = 0; i < 180; i += 5) {
+      display.drawPixel(106 + fixedMulQ15(radius, fixedCos(i)),
+                        13 - fixedMulQ15(radius, fixedSin(i)), SSD1306_WHITE);
+    }
+  }
+  display.fillCircle(106, 13, 1, SSD1306_WHITE);
+}
+
+void benchAssets() {
+  uint32_t start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) proceduralWiFiIcon();
+  printResult("WiFi icon (procedural)", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) blitAsset(&display, ASSET_WIFI_ON, 100, 2);
+  printResult("WiFi icon (PackBits blit)", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) blitAsset(&display, ASSET_WIFI_ON, 100, 0);
+  printResult("WiFi icon (PackBits blit, page-aligned)", ESP.getCycleCount() - start);
+}
+
+// Glyphs per millisecond at the current CPU clock
+void printGlyphRate(const char* name, uint32_t cycles, int glyphs) {
+  uint32_t perMs = (uint64_t)glyphs * BENCH_ITERATIONS * ESP.getCpuFreqMHz() * 1000 / cycles;
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(perMs);
+  Serial.println(" glyphs/ms");
+}
+
+void benchFont() {
+  const char* text = "12:34:56";
+  int glyphs = strlen(text);
+
+  for (uint8_t size = 1; size <= FONT_MAX_SCALE; size++) {
+    display.setTextSize(size);
+    display.setTextColor(SSD1306_WHITE);
+    uint32_t start = ESP.getCycleCount();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+      display.setCursor(0, 16);
+      display.print(text);
+    }
+    Serial.print("Size ");
+    Serial.println(size);
+    printGlyphRate("  GFX print", ESP.getCycleCount() - start, glyphs);
+
+    start = ESP.getCycleCount();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) fastFont.drawText(0, 16, text, size);
+    printGlyphRate("  FastFont (page-aligned)", ESP.getCycleCount() - start, glyphs);
+
+    start = ESP.getCycleCount();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) fastFont.drawText(0, 19, text, size);
+    printGlyphRate("  FastFont (unaligned)", ESP.getCycleCount() - start, glyphs);
+  }
+  display.setTextSize(1);
+}
+
+void benchPrimitives() {
+  uint32_t start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) display.fillRect(10, 5, 100, 50, SSD1306_WHITE);
+  printResult("fillRect 100x50 (GFX)", ESP.getCycleCount() - start);
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) fbFillRect(&display, 10, 5, 100, 50, SSD1306_WHITE);
+  printResult("fillRect 100x50 (SWAR)", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) display.drawFastHLine(3, 21, 120, SSD1306_INVERSE);
+  printResult("hline 120 (GFX)", ESP.getCycleCount() - start);
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) fbDrawHLine(&display, 3, 21, 120, SSD1306_INVERSE);
+  printResult("hline 120 (SWAR)", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) display.drawFastVLine(64, 3, 58, SSD1306_WHITE);
+  printResult("vline 58 (GFX)", ESP.getCycleCount() - start);
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) fbDrawVLine(&display, 64, 3, 58, SSD1306_WHITE);
+  printResult("vline 58 (page masks)", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) display.fillCircle(64, 32, 20, SSD1306_WHITE);
+  printResult("fillCircle r20 (GFX)", ESP.getCycleCount() - start);
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) fbFillCircle(&display, 64, 32, 20, SSD1306_WHITE);
+  printResult("fillCircle r20 (span table)", ESP.getCycleCount() - start);
+
+  static uint8_t frame[SCREEN_WIDTH * SCREEN_HEIGHT / 8];
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) fbXorBytes(display.getBuffer(), frame, sizeof(frame));
+  printResult("XOR full frame", ESP.getCycleCount() - start);
+
+  volatile uint32_t lit = 0;
+  start = ESP.getCycleCount();
+  for (int i = 0; i < BENCH_ITERATIONS; i++) lit += fbPopcount(display.getBuffer(), sizeof(frame));
+  printResult("popcount full frame", ESP.getCycleCount() - start);
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+
+  Wire.begin(8, 9);
+  if(!display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS)) {
+    Serial.println(F("SSD1306 allocation failed"));
+    for(;;);
+  }
+
+  Serial.println("=== Render Benchmark ===");
+  benchArcs();
+  benchEmojis();
+  benchSpriteCache();
+  benchAssets();
+  benchFont();
+  benchPrimitives();
+  Serial.println("Done");
+}
+
+void loop() {
+}
@@ -0,0 +1,258 @@
+/*
+ * Mochi Robot - Screen Transition Test
+ * Replays each transition plan on a model of the SSD1306 GDDRAM, start
+ * line and horizontal/diagonal scroll registers, and checks every
+ * intermediate frame and the final one
+ * Runs on the board (no panel needed), results are printed over Serial
+ */
+
+#include <Arduino.h>
+#include "screen_transition.h"
+#include "test_check.h"
+
+#define RAM_PAGES (TRANSITION_RAM_ROWS / 8)
+#define MODEL_PANEL_FPS 100 // Frame rate assumed for the scroll model
+
+uint8_t oldFrame[Panel::frameBytes];
+uint8_t newFrame[Panel::frameBytes];
+
+// What the controller holds and shows
+struct PanelModel {
+  uint8_t ram[RAM_PAGES][Panel::width];
+  int startLine;
+  int scrollDirection; // -1 left, +1 right, 0 off
+  bool diagonal;       // Screensaver scroll: right and up, left running
+  bool wroteWhileScrolling;
+  unsigned long bytesWritten;
+  unsigned long holdMs;
+
+  void load(const uint8_t* frame) {
+    memset(ram, 0, sizeof(ram));
+    memcpy(ram, frame, Panel::frameBytes);
+    startLine = 0;
+    scrollDirection = 0;
+    diagonal = false;
+    wroteWhileScrolling = false;
+    bytesWritten = 0;
+    holdMs = 0;
+  }
+
+  void scrollColumns(int columns) {
+    uint8_t row[Panel::width];
+    for (int page = 0; page < Panel::pages; page++) {
+      for (int x = 0; x < Panel::width; x++) {
+        int from = (x - scrollDirection * columns) % Panel::width;
+        if (from < 0) from += Panel::width;
+        row[x] = ram[page][from];
+      }
+      memcpy(ram[page], row, Panel::width);
+    }
+  }
+
+  // One diagonal scroll step: a column to the right, SCREENSAVER_SCROLL_OFFSET
+  // rows up, both wrapping within the visible area
+  void scrollDiagonal(int steps) {
+    static uint8_t shifted[Panel::frameBytes];
+    for (int n = 0; n < steps; n++) {
+      memset(shifted, 0, sizeof(shifted));
+      for (int y = 0; y < Panel::height; y++) {
+        int fromY = (y + SCREENSAVER_SCROLL_OFFSET) % Panel::height;
+        for (int x = 0; x < Panel::width; x++) {
+          int fromX = (x + Panel::width - 1) % Panel::width;
+          if ((ram[fromY / 8][fromX] >> (fromY & 7)) & 1) shifted[x + (y / 8) * Panel::width] |= 1 << (y & 7);
+        }
+      }
+      memcpy(ram, shifted, Panel::frameBytes);
+    }
+  }
+
+  void apply(const TransitionStep& step, const uint8_t* frame) {
+    if (step.scroll == SCROLL_START_LEFT) scrollDirection = -1;
+    if (step.scroll == SCROLL_START_RIGHT) scrollDirection = 1;
+    if (step.scroll == SCROLL_START_DIAGONAL) diagonal = true;
+    if (step.scroll == SCROLL_STOP) {
+      scrollDirection = 0;
+      diagonal = false;
+    }
+    if (step.startLine >= 0) startLine = step.startLine;
+    if (step.ramPage >= 0) {
+      if (scrollDirection != 0 || diagonal) wroteWhileScrolling = true;
+      memcpy(ram[step.ramPage], frame + step.framePage * Panel::width, Panel::width);
+      bytesWritten += Panel::width;
+    }
+    if (step.holdMs > 0 && scrollDirection != 0) {
+      // Interval code 7: one column every 2 panel frames
+      scrollColumns(step.holdMs * MODEL_PANEL_FPS / 2000);
+    }
+    holdMs += step.holdMs;
+  }
+
+  bool pixel(int x, int y) {
+    int row = (startLine + y) % TRANSITION_RAM_ROWS;
+    return (ram[row / 8][x] >> (row & 7)) & 1;
+  }
+};
+
+PanelModel panel;
+
+bool framePixel(const uint8_t* frame, int x, int y) {
+  return (frame[x + (y / 8) * Panel::width] >> (y & 7)) & 1;
+}
+
+void fillFrames() {
+  memset(oldFrame, 0, sizeof(oldFrame));
+  memset(newFrame, 0, sizeof(newFrame));
+  for (int y = 0; y < Panel::height; y++) {
+    for (int x = 0; x < Panel::width; x++) {
+      if ((x * 7 + y * 3) % 11 < 4) oldFrame[x + (y / 8) * Panel::width] |= 1 << (y & 7);
+      if ((x + y * 5) % 7 == 0 || y == 0) newFrame[x + (y / 8) * Panel::width] |= 1 << (y & 7);
+    }
+  }
+}
+
+// Old screen moved by `offset` rows with the new one following it in
+bool showsSlide(TransitionType type, int offset) {
+  for (int y = 0; y < Panel::height; y++) {
+    for (int x = 0; x < Panel::width; x++) {
+      bool expected;
+      if (type == TRANSITION_SLIDE_UP) {
+        expected = (y + offset < Panel::height) ? framePixel(oldFrame, x, y + offset)
+                                                : framePixel(newFrame, x, y + offset - Panel::height);
+      } else {
+        expected = (y < offset) ? framePixel(newFrame, x, Panel::height - offset + y)
+                                : framePixel(oldFrame, x, y - offset);
+      }
+      if (panel.pixel(x, y) != expected) return false;
+    }
+  }
+  return true;
+}
+
+bool showsFrame(const uint8_t* frame) {
+  for (int y = 0; y < Panel::height; y++) {
+    for (int x = 0; x < Panel::width; x++) {
+      if (panel.pixel(x, y) != framePixel(frame, x, y)) return false;
+    }
+  }
+  return true;
+}
+
+void printCost(const char* name, int steps) {
+  Serial.print("  ");
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(steps);
+  Serial.print(" steps, ");
+  Serial.print(panel.bytesWritten);
+  Serial.print(" bytes, ");
+  Serial.print(panel.holdMs);
+  Serial.println(" ms");
+}
+
+void testSlide(TransitionType type, const char* name) {
+  panel.load(oldFrame);
+  ScreenTransition plan(type);
+  TransitionStep step;
+  int steps = 0;
+  int slidFrames = 0;
+  bool slideOk = true;
+
+  while (plan.next(step)) {
+    panel.apply(step, newFrame);
+    steps++;
+    if (step.startLine > 0 && step.holdMs > 0) {
+      // Mid-slide: how far the old screen has moved
+      int offset = (type == TRANSITION_SLIDE_UP) ? step.startLine
+                                                 : (TRANSITION_RAM_ROWS - step.startLine) % TRANSITION_RAM_ROWS;
+      if (!showsSlide(type, offset)) slideOk = false;
+      slidFrames++;
+    }
+  }
+
+  printCost(name, steps);
+  check(slideOk && slidFrames > 0, "intermediate frames are the shifted screens");
+  check(showsFrame(newFrame) && panel.startLine == 0, "ends on the new frame at start line 0");
+  check(panel.bytesWritten <= 2 * Panel::frameBytes, "writes at most two frames of data");
+}
+
+void testScroll(TransitionType type, const char* name) {
+  panel.load(oldFrame);
+  ScreenTransition plan(type);
+  TransitionStep step;
+  int steps = 0;
+  bool moved = false;
+
+  while (plan.next(step)) {
+    panel.apply(step, newFrame);
+    steps++;
+    if (step.scroll == SCROLL_STOP) {
+      moved = !showsFrame(oldFrame); // The panel scrolled the old screen by itself
+    }
+  }
+
+  printCost(name, steps);
+  check(moved, "hardware scroll moved the old screen");
+  check(!panel.wroteWhileScrolling, "no RAM writes while scrolling");
+  check(showsFrame(newFrame) && panel.scrollDirection == 0, "ends on the new frame, scroll off");
+  check(panel.bytesWritten == Panel::frameBytes, "writes one frame of data");
+}
+
+void testScreensaver() {
+  panel.load(oldFrame);
+  ScreenTransition plan(TRANSITION_SCREENSAVER);
+  TransitionStep step;
+  int steps = 0;
+  bool held = false;
+
+  while (plan.next(step)) {
+    panel.apply(step, newFrame);
+    steps++;
+    if (step.holdMs > 0) held = true;
+  }
+
+  printCost("Screensaver", steps);
+  check(showsFrame(newFrame) && panel.diagonal, "writes the scene, then leaves the scroll running");
+  check(!panel.wroteWhileScrolling && !held, "no writes or waits once scrolling");
+  check(panel.bytesWritten == Panel::frameBytes, "writes one frame of data");
+
+  // The controller keeps moving it on its own
+  const int drift = Panel::height + 5;
+  panel.scrollDiagonal(drift);
+  bool drifted = true;
+  for (int y = 0; y < Panel::height; y++) {
+    for (int x = 0; x < Panel::width; x++) {
+      int fromX = ((x - drift) % Panel::width + Panel::width) % Panel::width;
+      int fromY = (y + drift * SCREENSAVER_SCROLL_OFFSET) % Panel::height;
+      if (panel.pixel(x, y) != framePixel(newFrame, fromX, fromY)) drifted = false;
+    }
+  }
+  check(drifted, "scene drifts right and up, wrapping around");
+
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+
+  Serial.println("=== Screen Transition Test ===");
+  Serial.print("Panel ");
+  Serial.print(Panel::width);
+  Serial.print("x");
+  Serial.println(Panel::height);
+
+  fillFrames();
+  testSlide(TRANSITION_SLIDE_UP, "Slide up");
+  testSlide(TRANSITION_SLIDE_DOWN, "Slide down");
+  testScroll(TRANSITION_SCROLL_LEFT, "Scroll left");
+  testScroll(TRANSITION_SCROLL_RIGHT, "Scroll right");
+  testScreensaver();
+
+  ScreenTransition none(TRANSITION_NONE);
+  TransitionStep step;
+  check(!none.next(step), "TRANSITION_NONE has no steps");
+
+  printTestSummary();
+}
+
+void loop() {
+}
@@ -0,0 +1,242 @@
+/*
+ * Mochi Robot - Widget Screen Test
+ * Renders every ScreenManager screen through the widget tree, prints it
+ * as ASCII art and checks that only changed widgets are redrawn and the
+ * status bar layer is only re-rendered when its inputs change, and that
+ * screens pre-rendered while idle switch in exactly as a full render would
+ * Runs on the board, results are printed over Serial
+ */
+
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "mochi_display.h"
+#include "screen_manager.h"
+#include "compositor.h"
+#include "test_check.h"
+
+#define FRAME_BYTES Panel::frameBytes
+
+MochiDisplay display(&Wire, -1);
+Compositor compositor;
+ScreenManager screenManager(&display, &compositor);
+uint8_t snapshot[FRAME_BYTES];
+
+void printFrame(const char* title) {
+  Serial.print("--- ");
+  Serial.println(title);
+  const uint8_t* buffer = display.getFrame();
+  char row[Panel::width + 1];
+  row[Panel::width] = '\0';
+  for (int y = 0; y < Panel::height; y++) {
+    for (int x = 0; x < Panel::width; x++) {
+      row[x] = (buffer[x + (y / 8) * Panel::width] & (1 << (y & 7))) ? '#' : '.';
+    }
+    Serial.println(row);
+  }
+}
+
+void takeSnapshot() {
+  memcpy(snapshot, display.getFrame(), FRAME_BYTES);
+}
+
+bool sameAsSnapshot() {
+  return memcmp(snapshot, display.getFrame(), FRAME_BYTES) == 0;
+}
+
+// An incremental redraw must leave exactly what a full redraw would
+bool matchesFullRedraw() {
+  takeSnapshot();
+  screenManager.setScreen(screenManager.getCurrentScreen());
+  screenManager.draw();
+  return sameAsSnapshot();
+}
+
+void showScreen(ScreenType screen, const char* title) {
+  screenManager.setScreen(screen);
+  screenManager.draw();
+  printFrame(title);
+
+  takeSnapshot();
+  screenManager.draw();
+  check(screenManager.getLastWidgetsDrawn() == 0 && sameAsSnapshot(), "unchanged screen draws nothing");
+}
+
+void testScreens() {
+  showScreen(SCREEN_CLOCK, "Clock (no sync)");
+
+  screenManager.setNextPrayer("Asr", "15:42", 37);
+  showScreen(SCREEN_PRAYER_TIME, "Prayer");
+
+  screenManager.setWeather(23.5, WEATHER_RAIN, true);
+  showScreen(SCREEN_WEATHER, "Weather");
+
+  screenManager.setWiFiInfo("MochiHomeNetwork5G-Extended", "192.168.1.42", -61);
+  screenManager.setBluetoothEnabled(true);
+  for (int page = 0; page < 4; page++) {
+    if (page == 1) {
+      screenManager.setLastWeatherUpdate("12:00");
+      screenManager.setLastNTPUpdate("11:58");
+    }
+    char title[20];
+    snprintf(title, sizeof(title), "Settings page %d", page + 1);
+    showScreen(SCREEN_SETTINGS, title);
+    screenManager.nextSettingsPage();
+  }
+}
+
+void testPartialRedraw() {
+  // Signal change: the signal row only
+  screenManager.setScreen(SCREEN_SETTINGS);
+  while (screenManager.getSettingsPage() != 0) screenManager.nextSettingsPage();
+  screenManager.draw();
+  screenManager.setWiFiInfo("MochiHomeNetwork5G-Extended", "192.168.1.42", -72);
+  screenManager.draw();
+  check(screenManager.getLastWidgetsDrawn() == 1, "RSSI change redraws one row");
+  check(matchesFullRedraw(), "RSSI change matches full redraw");
+
+  // Page switch reuses the rows
+  screenManager.nextSettingsPage();
+  screenManager.draw();
+  check(matchesFullRedraw(), "settings page switch matches full redraw");
+
+  // Temperature change keeps the cached label and condition text
+  screenManager.setScreen(SCREEN_WEATHER);
+  screenManager.draw();
+  screenManager.setWeather(-4.0, WEATHER_SNOW, false);
+  screenManager.draw();
+  check(matchesFullRedraw(), "weather change matches full redraw");
+  printFrame("Weather (updated)");
+
+  // Data arriving swaps the hint for the overlapping clock widgets
+  screenManager.setScreen(SCREEN_CLOCK);
+  screenManager.setTimeSynced(false);
+  screenManager.draw();
+  screenManager.setTimeSynced(true);
+  screenManager.draw();
+  check(matchesFullRedraw(), "clock sync matches full redraw");
+  printFrame("Clock (synced)");
+}
+
+// Bytes that differ from the snapshot outside the status bar strip
+int changesOutsideStatusBar() {
+  const uint8_t* buffer = display.getFrame();
+  int changes = 0;
+  for (int i = 0; i < FRAME_BYTES; i++) {
+    bool inStrip = i >= STATUS_BAR_X && i < STATUS_BAR_X + STATUS_BAR_WIDTH;
+    if (!inStrip && buffer[i] != snapshot[i]) changes++;
+  }
+  return changes;
+}
+
+void testStatusBar() {
+  screenManager.setScreen(SCREEN_PRAYER_TIME);
+  screenManager.draw();
+  printFrame("Prayer (status bar)");
+
+  // RSSI only: the status bar does not depend on it
+  unsigned long renders = compositor.getStatusRenders();
+  screenManager.setWiFiInfo("MochiHomeNetwork5G-Extended", "192.168.1.42", -55);
+  check(!compositor.needsCompose(), "RSSI change leaves status bar alone");
+  screenManager.draw();
+  check(compositor.getStatusRenders() == renders, "status bar not re-rendered");
+
+  // Bluetooth off: no widget changes, only the strip
+  takeSnapshot();
+  screenManager.setBluetoothEnabled(false);
+  check(compositor.needsCompose(), "Bluetooth change needs a compose");
+  screenManager.draw();
+  check(screenManager.getLastWidgetsDrawn() == 0, "Bluetooth change redraws no widgets");
+  check(compositor.getStatusRenders() == renders + 1, "status bar re-rendered once");
+  check(!sameAsSnapshot() && changesOutsideStatusBar() == 0, "only the status bar strip changed");
+  check(matchesFullRedraw(), "status change matches full redraw");
+
+  // Eyes use the whole panel
+  screenManager.setScreen(SCREEN_ROBOT_EYES);
+  display.canvas()->fillRect(0, 0, Panel::width, 8, SSD1306_WHITE);
+  display.display();
+  bool covered = true;
+  for (int i = STATUS_BAR_X; i < STATUS_BAR_X + STATUS_BAR_WIDTH; i++) {
+    if (display.getFrame()[i] != 0xFF) covered = false;
+  }
+  check(covered, "status bar hidden on the eyes screen");
+}
+
+void prerenderAll() {
+  while (screenManager.prerenderIdle()) {
+  }
+}
+
+void printSwitchLatency(const char* name) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(screenManager.getSwitchLatencyMicros());
+  Serial.println(" us to hand-off");
+}
+
+void testPrerender() {
+  // From the eyes a tap goes to the clock, a long press to Settings
+  screenManager.setScreen(SCREEN_ROBOT_EYES);
+  prerenderAll();
+  check(screenManager.isPrerendered(SCREEN_CLOCK) && screenManager.isPrerendered(SCREEN_SETTINGS),
+        "clock and settings pre-rendered from the eyes");
+  check(!screenManager.prerenderIdle(), "nothing left to pre-render");
+
+  // Data setters drop the stale frame, idle time renders it again
+  screenManager.setBluetoothEnabled(true);
+  check(!screenManager.isPrerendered(SCREEN_SETTINGS), "setter invalidates the pre-render");
+  check(screenManager.prerenderIdle() && screenManager.isPrerendered(SCREEN_SETTINGS),
+        "idle pass re-renders it");
+
+  unsigned long hits = screenManager.getPrerenderHits();
+  screenManager.nextScreen();
+  check(screenManager.getPrerenderHits() == hits + 1 && screenManager.wasLastSwitchPrerendered(),
+        "tap uses the pre-rendered clock");
+  check(matchesFullRedraw(), "pre-rendered clock matches full redraw");
+  printSwitchLatency("Clock (pre-rendered)");
+
+  // Next in the cycle follows the current screen
+  prerenderAll();
+  check(screenManager.isPrerendered(SCREEN_PRAYER_TIME), "prayer pre-rendered from the clock");
+  screenManager.setNextPrayer("Maghrib", "18:03", 12);
+  check(!screenManager.isPrerendered(SCREEN_PRAYER_TIME), "prayer update invalidates the pre-render");
+  prerenderAll();
+  screenManager.nextScreen();
+  check(screenManager.wasLastSwitchPrerendered(), "tap uses the pre-rendered prayer screen");
+  check(matchesFullRedraw(), "pre-rendered prayer matches full redraw");
+
+  screenManager.setScreen(SCREEN_SETTINGS, TRANSITION_SCROLL_LEFT);
+  check(screenManager.wasLastSwitchPrerendered(), "long press uses the pre-rendered settings");
+  check(matchesFullRedraw(), "pre-rendered settings matches full redraw");
+
+  // Weather was never pre-rendered from the eyes
+  screenManager.setScreen(SCREEN_ROBOT_EYES);
+  screenManager.setScreen(SCREEN_WEATHER);
+  screenManager.draw();
+  check(!screenManager.wasLastSwitchPrerendered(), "unprepared screen renders on switch");
+  printSwitchLatency("Weather (rendered)");
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+
+  Wire.begin(8, 9);
+  if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+    Serial.println(F("SSD1306 allocation failed"));
+    for(;;);
+  }
+
+  display.setCompositor(&compositor);
+
+  Serial.println("=== Widget Screen Test ===");
+  testScreens();
+  testPartialRedraw();
+  testStatusBar();
+  testPrerender();
+
+  printTestSummary();
+}
+
+void loop() {
+}